@@ -0,0 +1,97 @@
+#include <iostream>
+#include <memory>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+// 记录分配次数的分配器：每次分配应该是一整个slab。rebind以后还是同一个计数
+int allocations = 0;
+
+template<class T>
+struct counting_allocator : std::allocator<T> {
+	template<class U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator() = default;
+
+	template<class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(size_t n) {
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+typedef sjtu::map<int, int, std::less<int>, counting_allocator<sjtu::pair<const int, int>>> counted_map;
+
+template<class Map>
+bool consistent(const Map &m, size_t per_slab)
+{
+	return m.slab_count() * per_slab == m.size() + m.free_node_count();
+}
+
+void TestSlabReuse()
+{
+	std::cout << "Testing slab reuse..." << std::endl;
+	counted_map m;
+	std::cout << m.slab_count() << " " << m.free_node_count() << std::endl;
+	m[0] = 0;
+	size_t per_slab = m.free_node_count() + 1;
+	std::cout << m.slab_count() << " " << (per_slab >= 16) << std::endl;
+	int n = (int) per_slab * 3;
+	for (int i = 1; i < n; ++i) {
+		m[i] = i;
+	}
+	std::cout << m.slab_count() << " " << m.free_node_count() << " " << consistent(m, per_slab) << std::endl;
+	for (int i = 0; i < n; i += 2) {
+		m.erase(m.find(i));
+	}
+	size_t freed = m.free_node_count();
+	std::cout << (m.size() == (size_t) n / 2) << " " << m.slab_count() << " " << (freed == (size_t) n / 2) << " "
+	          << consistent(m, per_slab) << std::endl;
+	for (int i = 0; i < n; i += 2) {
+		m[i + n] = i;
+	}
+	std::cout << (m.size() == (size_t) n) << " " << m.slab_count() << " " << m.free_node_count() << " "
+	          << consistent(m, per_slab) << std::endl;
+	m[-1] = -1;
+	std::cout << m.slab_count() << " " << (m.free_node_count() == per_slab - 1) << std::endl;
+	m.clear();
+	std::cout << m.size() << " " << m.slab_count() << " " << consistent(m, per_slab) << std::endl;
+	for (int i = 0; i < n; ++i) {
+		m[i] = i;
+	}
+	std::cout << m.slab_count() << " " << consistent(m, per_slab) << std::endl;
+}
+
+void TestSlabAllocations()
+{
+	std::cout << "Testing allocations per slab..." << std::endl;
+	int before = allocations;
+	counted_map m;
+	for (int i = 0; i < 1000; ++i) {
+		m[i * 7 % 1000] = i;
+	}
+	int used = allocations - before;
+	std::cout << (used == (int) m.slab_count()) << " " << (m.slab_count() < 1000 / 16 + 1) << std::endl;
+	before = allocations;
+	counted_map c(m);
+	std::cout << (allocations - before == (int) c.slab_count()) << " " << (c.slab_count() == m.slab_count()) << std::endl;
+	before = allocations;
+	for (int i = 0; i < 1000; i += 3) {
+		c.erase(c.find(i));
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		c[i] = -i;
+	}
+	std::cout << (allocations == before) << " " << c.size() << std::endl;
+}
+
+int main()
+{
+	TestSlabReuse();
+	TestSlabAllocations();
+	return 0;
+}
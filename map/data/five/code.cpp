@@ -0,0 +1,31 @@
+#include <iostream>
+#include <string>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+void TestHeterogeneousLookup()
+{
+	std::cout << "Testing heterogeneous lookup..." << std::endl;
+	sjtu::map<std::string, int, std::less<>> m;
+	const char *words[] = {"pear", "apple", "fig", "plum", "kiwi"};
+	for (int i = 0; i < 5; ++i) {
+		m[words[i]] = i;
+	}
+	std::cout << m.find("fig")->second << " " << (m.find("lime") == m.end()) << std::endl;
+	std::cout << m.count("plum") << " " << m.count("grape") << std::endl;
+	std::cout << m.at("kiwi") << std::endl;
+	std::cout << m.lower_bound("orange")->first << std::endl;
+	try {
+		m.at("lime");
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	const sjtu::map<std::string, int, std::less<>> &cm = m;
+	std::cout << cm.find("apple")->second << std::endl;
+}
+
+int main()
+{
+	TestHeterogeneousLookup();
+	return 0;
+}
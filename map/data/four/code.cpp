@@ -0,0 +1,70 @@
+#include <iostream>
+#include <string>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+template<class Map>
+void print(const Map &m)
+{
+	for (typename Map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		std::cout << it->first << ":" << it->second << " ";
+	}
+	std::cout << "| size = " << m.size() << std::endl;
+}
+
+template<class Result>
+void show(const Result &r)
+{
+	std::cout << r.first->first << ":" << r.first->second << " " << r.second << std::endl;
+}
+
+// 记录复制和移动的次数：新节点的值应该原地构造
+struct Counted {
+	static int copies;
+	int v;
+
+	Counted() : v(0) {}
+
+	Counted(int a, int b) : v(a * b) {}
+
+	Counted(const Counted &other) : v(other.v) {
+		++copies;
+	}
+
+	Counted(Counted &&other) : v(other.v) {
+		++copies;
+	}
+};
+int Counted::copies = 0;
+
+void TestTryEmplace()
+{
+	std::cout << "Testing try_emplace and insert_or_assign..." << std::endl;
+	sjtu::map<int, std::string> m;
+	show(m.try_emplace(1, 3, 'x'));
+	std::string s = "kept";
+	show(m.try_emplace(1, std::move(s)));
+	std::cout << s << std::endl;
+	show(m.try_emplace(2, std::move(s)));
+	show(m.insert_or_assign(1, std::string("new")));
+	show(m.insert_or_assign(3, std::string("three")));
+	std::cout << m[4].size() << std::endl;
+	print(m);
+}
+
+void TestInPlace()
+{
+	std::cout << "Testing in-place construction of values..." << std::endl;
+	sjtu::map<int, Counted> m;
+	m.try_emplace(1, 6, 7);
+	m.try_emplace(1, 2, 3);
+	m[2].v = 5;
+	std::cout << m[1].v << " " << m[2].v << " " << Counted::copies << std::endl;
+}
+
+int main()
+{
+	TestTryEmplace();
+	TestInPlace();
+	return 0;
+}
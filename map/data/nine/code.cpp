@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+typedef sjtu::map<int, std::string> string_map;
+
+const int N = 300000;
+
+// 按顺序检查所有的键和值，值由键决定
+bool intact(const string_map &m, int n, int step)
+{
+	if (m.size() != (size_t) n) return false;
+	int k = 0;
+	for (string_map::const_iterator it = m.cbegin(); it != m.cend(); ++it, k += step) {
+		if (it->first != k || it->second != std::to_string(k)) return false;
+	}
+	return k == n * step;
+}
+
+void TestCopySorted()
+{
+	std::cout << "Testing copy and clear of a map built by assign_sorted..." << std::endl;
+	std::vector<sjtu::pair<const int, std::string>> v;
+	for (int i = 0; i < N; ++i) {
+		v.push_back(sjtu::pair<const int, std::string>(i * 2, std::to_string(i * 2)));
+	}
+	string_map m;
+	m.assign_sorted(v.begin(), v.end());
+	string_map c(m);
+	std::cout << intact(m, N, 2) << " " << intact(c, N, 2) << std::endl;
+	m.clear();
+	std::cout << m.size() << " " << (m.begin() == m.end()) << " " << intact(c, N, 2) << std::endl;
+	m[1] = "1";
+	c.erase(c.find(0));
+	std::cout << m.size() << " " << c.size() << " " << c.begin()->first << std::endl;
+	m = c;
+	c.clear();
+	std::cout << c.empty() << " " << m.size() << " " << m.begin()->first << " " << (--m.end())->first << std::endl;
+}
+
+void TestCopyAscending()
+{
+	std::cout << "Testing copy and clear of a map built in ascending order..." << std::endl;
+	string_map m;
+	for (int i = 0; i < N; ++i) {
+		m[i] = std::to_string(i);
+	}
+	string_map c;
+	c[-5] = "old";
+	c = m;
+	for (int i = 0; i < N; i += 2) {
+		m.erase(m.find(i));
+	}
+	std::cout << intact(c, N, 1) << " " << m.size() << " " << m.begin()->first << std::endl;
+	string_map d(c);
+	c.clear();
+	c.clear();
+	std::cout << c.size() << " " << intact(d, N, 1) << std::endl;
+	for (int i = N - 1; i >= 0; --i) {
+		c[i] = std::to_string(i);
+	}
+	std::cout << intact(c, N, 1) << " " << intact(d, N, 1) << std::endl;
+}
+
+int main()
+{
+	TestCopySorted();
+	TestCopyAscending();
+	return 0;
+}
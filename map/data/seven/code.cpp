@@ -0,0 +1,115 @@
+#include <iostream>
+#include <vector>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+typedef sjtu::map<int, int> plain_map;
+typedef sjtu::map<int, int, std::less<int>, std::allocator<sjtu::pair<const int, int>>, true> threaded_map;
+
+unsigned rand_next() {
+	static unsigned reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) >> 1;
+}
+
+// 正向和反向各走一遍，和不带线索的map比较
+bool same(threaded_map &t, plain_map &p)
+{
+	if (t.size() != p.size()) return false;
+	threaded_map::iterator ti = t.begin();
+	plain_map::iterator pi = p.begin();
+	for (; pi != p.end(); ++ti, ++pi) {
+		if (ti == t.end() || ti->first != pi->first || ti->second != pi->second) return false;
+	}
+	if (ti != t.end()) return false;
+	while (pi != p.begin()) {
+		--ti;
+		--pi;
+		if (ti->first != pi->first || ti->second != pi->second) return false;
+	}
+	if (ti != t.begin()) return false;
+	const threaded_map &ct = t;
+	threaded_map::const_iterator ci = ct.cend();
+	for (size_t n = 0; n < ct.size(); ++n) --ci;
+	return ci == ct.cbegin();
+}
+
+void TestMixed()
+{
+	std::cout << "Testing threaded map under insert and erase..." << std::endl;
+	threaded_map t;
+	plain_map p;
+	bool ok = true;
+	for (int round = 0; round < 4000; ++round) {
+		int key = rand_next() % 500;
+		if (rand_next() % 3 == 0) {
+			threaded_map::iterator it = t.find(key);
+			if (it != t.end()) {
+				t.erase(it);
+				p.erase(p.find(key));
+			}
+		} else {
+			t[key] = round;
+			p[key] = round;
+		}
+		if (round % 400 == 0) ok = ok && same(t, p);
+	}
+	ok = ok && same(t, p);
+	while (t.size() > 10) {
+		int key = t.begin()->first;
+		t.erase(t.begin());
+		p.erase(p.find(key));
+		threaded_map::iterator last = t.end();
+		--last;
+		key = last->first;
+		t.erase(last);
+		p.erase(p.find(key));
+	}
+	ok = ok && same(t, p);
+	std::cout << (ok ? "ok." : "wrong.") << " " << t.size() << std::endl;
+}
+
+void TestCopyClearAssign()
+{
+	std::cout << "Testing threaded map copy, clear and assign_sorted..." << std::endl;
+	threaded_map t;
+	plain_map p;
+	for (int i = 0; i < 300; ++i) {
+		int key = rand_next() % 1000;
+		t[key] = i;
+		p[key] = i;
+	}
+	threaded_map c(t);
+	bool ok = same(c, p);
+	threaded_map a;
+	a[5] = 5;
+	a = t;
+	ok = ok && same(a, p);
+	t.clear();
+	plain_map empty;
+	ok = ok && same(t, empty) && same(c, p);
+	for (int i = 0; i < 50; ++i) {
+		t[i * 3] = i;
+		empty[i * 3] = i;
+	}
+	ok = ok && same(t, empty);
+	std::vector<sjtu::pair<const int, int>> sorted;
+	for (int i = 0; i < 200; ++i) {
+		sorted.push_back(sjtu::pair<const int, int>(i * 2, i));
+	}
+	t.assign_sorted(sorted.begin(), sorted.end());
+	p.assign_sorted(sorted.begin(), sorted.end());
+	ok = ok && same(t, p);
+	t.erase(t.find(100));
+	t[101] = 7;
+	p.erase(p.find(100));
+	p[101] = 7;
+	ok = ok && same(t, p);
+	std::cout << (ok ? "ok." : "wrong.") << " " << t.size() << " " << c.size() << std::endl;
+}
+
+int main()
+{
+	TestMixed();
+	TestCopyClearAssign();
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+typedef sjtu::pair<const int, std::string> entry;
+
+template<class Map>
+void print(const Map &m)
+{
+	for (typename Map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		std::cout << it->first << ":" << it->second << " ";
+	}
+	std::cout << "| size = " << m.size() << std::endl;
+}
+
+// 比较次数用完时抛出异常，用来检查批量建树在异常时不改变map
+struct LimitedLess {
+	static int budget;
+	bool operator()(int a, int b) const {
+		if (budget >= 0 && budget-- == 0) throw std::logic_error("comparison budget");
+		return a < b;
+	}
+};
+int LimitedLess::budget = -1;
+
+void TestThrowingComparator()
+{
+	std::cout << "Testing a throwing comparator..." << std::endl;
+	std::vector<entry> v;
+	for (int i = 0; i < 40; ++i) {
+		v.push_back(entry((i * 17) % 40, std::to_string(i)));
+	}
+	sjtu::map<int, std::string, LimitedLess> m;
+	m[100] = "old";
+	m[200] = "map";
+	int thrown = 0;
+	for (int budget = 0; budget < 300; budget += 7) {
+		LimitedLess::budget = budget;
+		try {
+			if (budget % 2 == 0) {
+				m.assign(v.begin(), v.end());
+			} else {
+				m.assign_sorted(v.begin(), v.end());
+			}
+		} catch (std::logic_error &) {
+			++thrown;
+		} catch (sjtu::runtime_error &) {
+		}
+		LimitedLess::budget = -1;
+		if (m.size() != 2 && m.size() != 40) {
+			std::cout << "wrong size " << m.size() << std::endl;
+		}
+		if (m.size() == 40) {
+			m.clear();
+			m[100] = "old";
+			m[200] = "map";
+		}
+	}
+	std::cout << (thrown > 0) << std::endl;
+	print(m);
+}
+
+int main()
+{
+	TestThrowingComparator();
+	return 0;
+}
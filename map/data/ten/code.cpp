@@ -0,0 +1,106 @@
+#include <iostream>
+#include <vector>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+// 带状态的比较器：reversed为真时按降序排列
+struct Flip {
+	bool reversed;
+
+	explicit Flip(bool r = false) : reversed(r) {}
+
+	bool operator()(int a, int b) const {
+		return reversed ? b < a : a < b;
+	}
+};
+
+typedef sjtu::map<int, char, Flip> flip_map;
+
+void print(const flip_map &m)
+{
+	for (flip_map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		std::cout << it->first << ":" << it->second << " ";
+	}
+	std::cout << "| size = " << m.size() << std::endl;
+}
+
+void fill(flip_map &m)
+{
+	int keys[] = {5, 1, 9, 3, 7};
+	for (int i = 0; i < 5; ++i) {
+		m[keys[i]] = 'a' + i;
+	}
+}
+
+void TestOrder()
+{
+	std::cout << "Testing a stateful comparator..." << std::endl;
+	flip_map up, down(Flip(true));
+	fill(up);
+	fill(down);
+	print(up);
+	print(down);
+	std::cout << up.key_comp()(1, 2) << " " << down.key_comp()(1, 2) << " " << down.key_comp().reversed << std::endl;
+	flip_map::value_type a(1, 'x'), b(2, 'y');
+	std::cout << up.value_comp()(a, b) << " " << down.value_comp()(a, b) << std::endl;
+	std::cout << down.lower_bound(6)->first << " " << down.upper_bound(5)->first << " " << down.find(3)->second << std::endl;
+	flip_map::iterator last = down.end();
+	--last;
+	std::cout << down.begin()->first << " " << last->first << std::endl;
+}
+
+void TestCopyKeepsState()
+{
+	std::cout << "Testing copy and assignment of the comparator..." << std::endl;
+	flip_map down(Flip(true));
+	fill(down);
+	flip_map copy(down);
+	copy[4] = 'z';
+	print(copy);
+	std::cout << copy.key_comp().reversed << std::endl;
+	flip_map up;
+	up[100] = 'q';
+	up = down;
+	std::cout << up.key_comp().reversed << std::endl;
+	up[8] = 'w';
+	up[0] = 'v';
+	print(up);
+	flip_map back(Flip(true));
+	back = flip_map();
+	back[2] = 'm';
+	back[6] = 'n';
+	std::cout << back.key_comp().reversed << " " << back.begin()->first << std::endl;
+	print(down);
+}
+
+void TestBulkWithState()
+{
+	std::cout << "Testing bulk construction with a stateful comparator..." << std::endl;
+	std::vector<flip_map::value_type> v;
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(flip_map::value_type(i * 3 % 7, 'a' + i));
+	}
+	flip_map m(v.begin(), v.end(), Flip(true));
+	print(m);
+	std::vector<flip_map::value_type> sorted;
+	for (int i = 10; i > 0; i -= 2) {
+		sorted.push_back(flip_map::value_type(i, 'A' + i));
+	}
+	flip_map s(sjtu::sorted_unique, sorted.begin(), sorted.end(), Flip(true));
+	print(s);
+	try {
+		flip_map wrong(sjtu::sorted_unique, sorted.begin(), sorted.end(), Flip(false));
+	} catch (sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	m.assign_sorted(sorted.begin(), sorted.end());
+	print(m);
+}
+
+int main()
+{
+	TestOrder();
+	TestCopyKeepsState();
+	TestBulkWithState();
+	return 0;
+}
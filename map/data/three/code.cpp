@@ -0,0 +1,53 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "exceptions.hpp"
+#include "map.hpp"
+
+typedef sjtu::pair<const int, std::string> entry;
+
+template<class Map>
+void print(const Map &m)
+{
+	for (typename Map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		std::cout << it->first << ":" << it->second << " ";
+	}
+	std::cout << "| size = " << m.size() << std::endl;
+}
+
+void TestBulkAssign()
+{
+	std::cout << "Testing bulk assign..." << std::endl;
+	std::vector<entry> unsorted;
+	int keys[] = {5, 3, 9, 1, 3, 7, 5, 2};
+	for (int i = 0; i < 8; ++i) {
+		unsorted.push_back(entry(keys[i], std::string(1, 'a' + i)));
+	}
+	sjtu::map<int, std::string> m(unsorted.begin(), unsorted.end());
+	print(m);
+	std::vector<entry> sorted;
+	for (int i = 0; i < 6; ++i) {
+		sorted.push_back(entry(i * 10, std::string(1, 'A' + i)));
+	}
+	sorted.push_back(entry(50, "dup"));
+	m.assign_sorted(sorted.begin(), sorted.end());
+	print(m);
+	try {
+		m.assign_sorted(unsorted.begin(), unsorted.end());
+	} catch (sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	print(m);
+	m.assign(unsorted.begin(), unsorted.end());
+	print(m);
+	m.assign(sorted.begin(), sorted.begin());
+	print(m);
+	sjtu::map<int, std::string>::iterator it = m.begin();
+	std::cout << (it == m.end()) << std::endl;
+}
+
+int main()
+{
+	TestBulkAssign();
+	return 0;
+}
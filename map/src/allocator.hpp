@@ -0,0 +1,320 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace sjtu {
+
+/**
+ * a monotonic memory resource.
+ * memory is carved from big blocks one after another and is never given back
+ *   one by one; reset() (or the destructor) frees everything at once.
+ * so a container living in an arena can be thrown away with a single reset(),
+ *   as long as nobody touches it afterwards.
+ */
+    class arena {
+    private:
+        struct block {
+            block *next;
+            size_t size;  //可用字节数，不含block头
+        };
+
+        block *head = nullptr;
+        char *cur = nullptr;   //当前块中下一个可用字节
+        char *last = nullptr;  //当前块的末尾
+        size_t block_size;
+        size_t used = 0;
+
+        static size_t align_up(size_t n, size_t align) {
+            return (n + align - 1) & ~(align - 1);
+        }
+
+        void new_block(size_t at_least) {
+            size_t size = block_size > at_least ? block_size : at_least;
+            void *raw = ::operator new(sizeof(block) + alignof(std::max_align_t) + size);
+            block *b = static_cast<block *>(raw);
+            b->next = head;
+            b->size = size;
+            head = b;
+            cur = reinterpret_cast<char *>(raw) + align_up(sizeof(block), alignof(std::max_align_t));
+            last = cur + size;
+        }
+
+    public:
+        explicit arena(size_t _block_size = 64 * 1024) : block_size(_block_size) {}
+
+        arena(const arena &) = delete;
+
+        arena &operator=(const arena &) = delete;
+
+        ~arena() {
+            release();
+        }
+
+        void *allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+            size_t space = static_cast<size_t>(last - cur);
+            size_t pad = align_up(reinterpret_cast<size_t>(cur), align) - reinterpret_cast<size_t>(cur);
+            if (cur == nullptr || pad + bytes > space) {
+                new_block(bytes + align);
+                pad = align_up(reinterpret_cast<size_t>(cur), align) - reinterpret_cast<size_t>(cur);
+            }
+            char *ret = cur + pad;
+            cur = ret + bytes;
+            used += bytes;
+            return ret;
+        }
+
+        /**
+         * drop every allocation at once.
+         * the newest block is kept for reuse, the others are returned to the system.
+         */
+        void reset() {
+            if (head == nullptr) return;
+            block *keep = head;
+            head = head->next;
+            release();
+            head = keep;
+            head->next = nullptr;
+            cur = reinterpret_cast<char *>(head) + align_up(sizeof(block), alignof(std::max_align_t));
+            last = cur + head->size;
+            used = 0;
+        }
+
+        /**
+         * return all the blocks to the system.
+         */
+        void release() {
+            while (head != nullptr) {
+                block *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+            cur = last = nullptr;
+            used = 0;
+        }
+
+        /**
+         * bytes handed out since the last reset.
+         */
+        size_t bytes_used() const {
+            return used;
+        }
+    };
+
+/**
+ * an allocator drawing from an arena. deallocate does nothing:
+ *   the memory comes back when the arena is reset.
+ * all the copies (and rebinds) of one arena_allocator share the same arena.
+ */
+    template<typename T>
+    class arena_allocator {
+        template<typename U> friend class arena_allocator;
+
+    private:
+        arena *source;
+
+    public:
+        using value_type = T;
+
+        explicit arena_allocator(arena &a) noexcept : source(&a) {}
+
+        template<typename U>
+        arena_allocator(const arena_allocator<U> &other) noexcept : source(other.source) {}
+
+        T *allocate(size_t n) {
+            return static_cast<T *>(source->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *, size_t) noexcept {}
+
+        arena &resource() const noexcept {
+            return *source;
+        }
+
+        template<typename U>
+        bool operator==(const arena_allocator<U> &rhs) const noexcept {
+            return source == rhs.source;
+        }
+
+        template<typename U>
+        bool operator!=(const arena_allocator<U> &rhs) const noexcept {
+            return source != rhs.source;
+        }
+    };
+
+/**
+ * the memory behind pool_allocator: one free list per object size and alignment.
+ */
+    class pool_resource {
+    private:
+        struct size_class {
+            size_t size;          //一个对象占的字节数，已按align取整
+            size_t align;
+            size_t total = 0;     //已经申请过的对象个数
+            size_class *next;
+            void *slabs = nullptr;      //每个slab开头存着下一个slab的地址
+            void *free_list = nullptr;  //空闲对象的开头存着下一个空闲对象的地址
+        };
+
+        size_class *classes = nullptr;
+
+        static size_t align_up(size_t n, size_t align) {
+            return (n + align - 1) & ~(align - 1);
+        }
+
+        static void *raw_allocate(size_t bytes, size_t align) {
+            if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) return ::operator new(bytes, std::align_val_t(align));
+            return ::operator new(bytes);
+        }
+
+        static void raw_deallocate(void *p, size_t align) noexcept {
+            if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) ::operator delete(p, std::align_val_t(align));
+            else ::operator delete(p);
+        }
+
+        //header占一个对象的位置之前，按align取整，保证后面的对象都对齐
+        static size_t header_size(const size_class *c) {
+            return align_up(sizeof(void *), c->align);
+        }
+
+        void new_slab(size_class *c, size_t max_objects) {
+            size_t count = (c->total > 0) ? c->total : 1;
+            if (count > max_objects) count = max_objects;
+            size_t limit = 64 * 1024 / c->size;
+            if (count > limit) count = (limit > 0) ? limit : 1;
+            char *raw = static_cast<char *>(raw_allocate(header_size(c) + count * c->size, c->align));
+            *reinterpret_cast<void **>(raw) = c->slabs;
+            c->slabs = raw;
+            c->total += count;
+            for (size_t i = count; i > 0; --i) {  //倒序放入，使得先取出的对象地址更小
+                void *obj = raw + header_size(c) + (i - 1) * c->size;
+                *static_cast<void **>(obj) = c->free_list;
+                c->free_list = obj;
+            }
+        }
+
+    public:
+        pool_resource() = default;
+
+        pool_resource(const pool_resource &) = delete;
+
+        pool_resource &operator=(const pool_resource &) = delete;
+
+        ~pool_resource() {
+            while (classes != nullptr) {
+                size_class *next = classes->next;
+                while (classes->slabs != nullptr) {
+                    void *next_slab = *static_cast<void **>(classes->slabs);
+                    raw_deallocate(classes->slabs, classes->align);
+                    classes->slabs = next_slab;
+                }
+                delete classes;
+                classes = next;
+            }
+        }
+
+        /**
+         * the free list for objects of this size and alignment, created on first use.
+         */
+        void *find(size_t size, size_t align) {
+            if (align < alignof(void *)) align = alignof(void *);
+            size = align_up(size > sizeof(void *) ? size : sizeof(void *), align);
+            for (size_class *c = classes; c != nullptr; c = c->next) {
+                if (c->size == size && c->align == align) return c;
+            }
+            classes = new size_class{size, align, 0, classes};
+            return classes;
+        }
+
+        void *allocate(void *cls, size_t max_objects) {
+            size_class *c = static_cast<size_class *>(cls);
+            if (c->free_list == nullptr) new_slab(c, max_objects);
+            void *ret = c->free_list;
+            c->free_list = *static_cast<void **>(ret);
+            return ret;
+        }
+
+        void deallocate(void *cls, void *p) noexcept {
+            size_class *c = static_cast<size_class *>(cls);
+            *static_cast<void **>(p) = c->free_list;
+            c->free_list = p;
+        }
+
+        /**
+         * memory for an array of objects, not pooled.
+         */
+        static void *allocate_array(size_t bytes, size_t align) {
+            return raw_allocate(bytes, align);
+        }
+
+        static void deallocate_array(void *p, size_t align) noexcept {
+            raw_deallocate(p, align);
+        }
+    };
+
+/**
+ * an allocator for single objects (e.g. tree or heap nodes).
+ * freed objects are kept in a free list and handed out again; memory is taken
+ *   from the system in slabs, each one twice as big as the one before,
+ *   up to objects_per_slab objects (or 64KB, whichever is smaller).
+ * requests for more than one object go straight to operator new.
+ * all the copies and rebinds of one pool_allocator share one pool_resource:
+ *   objects of the same size and alignment come from the same free list,
+ *   and the rebound allocators compare equal to the original.
+ */
+    template<typename T, size_t objects_per_slab = 256>
+    class pool_allocator {
+        template<typename U, size_t M> friend class pool_allocator;
+
+    private:
+        std::shared_ptr<pool_resource> state;
+        void *cls;  //state中大小和对齐与T相同的那一类
+
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = pool_allocator<U, objects_per_slab>;
+        };
+
+        pool_allocator() : state(std::make_shared<pool_resource>()), cls(state->find(sizeof(T), alignof(T))) {}
+
+        template<typename U>
+        pool_allocator(const pool_allocator<U, objects_per_slab> &other)
+                : state(other.state), cls(state->find(sizeof(T), alignof(T))) {}
+
+        T *allocate(size_t n) {
+            if (n != 1) return static_cast<T *>(pool_resource::allocate_array(n * sizeof(T), alignof(T)));
+            return static_cast<T *>(state->allocate(cls, objects_per_slab));
+        }
+
+        void deallocate(T *p, size_t n) noexcept {
+            if (p == nullptr) return;
+            if (n != 1) {
+                pool_resource::deallocate_array(p, alignof(T));
+                return;
+            }
+            state->deallocate(cls, p);
+        }
+
+        pool_resource &resource() const noexcept {
+            return *state;
+        }
+
+        template<typename U>
+        bool operator==(const pool_allocator<U, objects_per_slab> &rhs) const noexcept {
+            return state == rhs.state;
+        }
+
+        template<typename U>
+        bool operator!=(const pool_allocator<U, objects_per_slab> &rhs) const noexcept {
+            return !(*this == rhs);
+        }
+    };
+
+}
+
+#endif
@@ -7,8 +7,13 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "allocator.hpp"
 
 namespace sjtu {
 
@@ -19,9 +24,57 @@ namespace sjtu {
         bool flag = false;
     };
 
-    template<class Key, class T, class Compare = std::less<Key>>
+    /**
+     * tag telling a constructor that the input range is already sorted by key
+     *   (equal keys are allowed, only the first one is kept).
+     */
+    struct sorted_unique_t {
+        explicit sorted_unique_t() = default;
+    };
+    constexpr sorted_unique_t sorted_unique{};
+
+    //线索化的map在每个节点中额外保存中序遍历的前驱和后继；非线索化时这个基类是空的，不占空间。
+    template<bool Threaded, class Node>
+    struct map_node_thread {
+    };
+
+    template<class Node>
+    struct map_node_thread<true, Node> {
+        Node *prev = nullptr;
+        Node *next = nullptr;
+    };
+
+    //map保存的比较器。空的比较器(如std::less)作为基类存放，借助空基类优化不占任何空间。
+    template<class Compare, bool = std::is_empty<Compare>::value && !std::is_final<Compare>::value>
+    struct map_key_compare : private Compare {
+        explicit map_key_compare(const Compare &c) : Compare(c) {}
+
+        const Compare &get() const {
+            return *this;
+        }
+    };
+
+    template<class Compare>
+    struct map_key_compare<Compare, false> {
+        Compare cmp;
+
+        explicit map_key_compare(const Compare &c) : cmp(c) {}
 
-    class map {
+        const Compare &get() const {
+            return cmp;
+        }
+    };
+
+    /**
+     * a map based on an AVL tree.
+     * the leftmost and rightmost nodes are cached, so begin() and --end() are O(1).
+     * with Threaded = true every node also keeps its in-order neighbours, making
+     *   ++it and --it O(1) in the worst case for two more pointers per node.
+     */
+    template<class Key, class T, class Compare = std::less<Key>,
+            class Allocator = std::allocator<pair<const Key, T>>, bool Threaded = false>
+
+    class map : private map_key_compare<Compare> {
 
     public:
         /**
@@ -30,10 +83,28 @@ namespace sjtu {
          * You can use sjtu::map as value_type by typedef.
          */
         typedef pair<const Key, T> value_type;
+        typedef Allocator allocator_type;
+        typedef Compare key_compare;
+
+        /**
+         * compares two value_type by their keys with the map's comparator.
+         */
+        class value_compare {
+            friend class map;
+
+        protected:
+            Compare comp;
 
+            explicit value_compare(const Compare &c) : comp(c) {}
 
+        public:
+            bool operator()(const value_type &lhs, const value_type &rhs) const {
+                return comp(lhs.first, rhs.first);
+            }
+        };
 
-        struct node {
+
+        struct node : map_node_thread<Threaded, node> {
             value_type data;
             int height;
             node *lson;
@@ -42,8 +113,15 @@ namespace sjtu {
 
             //由于没有Key的默认构造函数，node的默认构造函数不应该被使用到。
 
-            node(value_type _data, int _h, node *_l, node *_r, node *_d) : data(_data), height(_h), lson(_l), rson(_r),
-                                                                           dad(_d) {};
+            node(const value_type &_data, int _h, node *_l, node *_r, node *_d) : data(_data), height(_h), lson(_l),
+                                                                                  rson(_r), dad(_d) {};
+
+            //新的叶子节点，值由key和构造T的参数args原地构造
+            template<class... Args>
+            node(node *_d, const Key &key, Args &&... args)
+                    : data(std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...)),
+                      height(1), lson(nullptr), rson(nullptr), dad(_d) {};
         };
 
         /**
@@ -61,7 +139,7 @@ namespace sjtu {
             // 在这个类空间里，iterator_assignable是一种独特的称呼，它是类型my_true_type的别名
             using iterator_assignable = my_true_type;
             node *ptr = nullptr;
-            map<Key, T, Compare> *this_map;
+            map *this_map;
             bool if_end; //表示是否是end()
 
             iterator() {
@@ -70,7 +148,7 @@ namespace sjtu {
                 if_end = false;
             }
 
-            iterator(node *p, map<Key, T, Compare> *t, bool b) : ptr(p), this_map(t), if_end(b) {}
+            iterator(node *p, map *t, bool b) : ptr(p), this_map(t), if_end(b) {}
 
             iterator(const iterator &other) {
                 ptr = other.ptr;
@@ -83,28 +161,7 @@ namespace sjtu {
              */
             iterator operator++(int) {
                 iterator iter(*this);
-                if (if_end) throw invalid_iterator();
-                if (ptr->rson != nullptr) {  //先找右子树中最小的那个
-                    ptr = ptr->rson;
-                    while (ptr->lson != nullptr) ptr = ptr->lson;
-                } else {  //没有右子树
-                    if (ptr->dad == nullptr) { //已经是最大的节点了
-                        if_end = true;  //变为迭代器end()
-                        ptr = nullptr;
-                    } else if (ptr == ptr->dad->rson) {  //是父节点的右儿子
-                        while (ptr->dad != nullptr && ptr == ptr->dad->rson) {
-                            ptr = ptr->dad;
-                        }
-                        if (ptr->dad == nullptr) { //已经是最大的节点了
-                            if_end = true;
-                            ptr = nullptr;
-                        } else {
-                            ptr = ptr->dad;
-                        }
-                    } else {
-                        ptr = ptr->dad;
-                    }
-                }
+                ++*this;
                 return iter;
             }
 
@@ -113,27 +170,8 @@ namespace sjtu {
              */
             iterator &operator++() {
                 if (if_end) throw invalid_iterator();
-                if (ptr->rson != nullptr) {  //先找右子树中最小的那个
-                    ptr = ptr->rson;
-                    while (ptr->lson != nullptr) ptr = ptr->lson;
-                } else {  //没有右子树
-                    if (ptr->dad == nullptr) { //已经是最大的节点了
-                        if_end = true;  //变为迭代器end()
-                        ptr = nullptr;
-                    } else if (ptr == ptr->dad->rson) {  //是父节点的右儿子
-                        while (ptr->dad != nullptr && ptr == ptr->dad->rson) {
-                            ptr = ptr->dad;
-                        }
-                        if (ptr->dad == nullptr) { //已经是最大的节点了
-                            if_end = true;
-                            ptr = nullptr;
-                        } else {
-                            ptr = ptr->dad;
-                        }
-                    } else {
-                        ptr = ptr->dad;
-                    }
-                }
+                ptr = successor(ptr);
+                if (ptr == nullptr) if_end = true;  //已经是最大的节点了，变为迭代器end()
                 return *this;
             }
 
@@ -144,37 +182,7 @@ namespace sjtu {
 
             iterator operator--(int) {
                 iterator iter(*this);
-                if (if_end) {  //是end 指针
-                    ptr = this_map->root;
-                    if (ptr == nullptr) throw invalid_iterator();
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                    if_end = false; //不再是end迭代器了
-                    return iter;
-                }
-                if (ptr->lson == nullptr) {
-                    if (ptr->dad == nullptr) {
-                        throw invalid_iterator(); //说明为迭代器begin;
-                    } else if (ptr == ptr->dad->lson) {
-                        node *temp = ptr;
-                        while (temp->dad != nullptr && temp == temp->dad->lson) {
-                            temp = temp->dad;
-                        }
-                        if (temp->dad == nullptr) {
-                            throw invalid_iterator(); //说明为迭代器begin;
-                        }
-                    }
-                }
-                if (ptr->lson != nullptr) { //找到左子树中最大的元素
-                    ptr = ptr->lson;
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                } else if (ptr == ptr->dad->rson) {  //已经排除了begin迭代器，保证了肯定有父节点
-                    ptr = ptr->dad;
-                } else {
-                    while (ptr == ptr->dad->lson) {
-                        ptr = ptr->dad;
-                    }
-                    ptr = ptr->dad;
-                }
+                --*this;
                 return iter;
             }
 
@@ -183,36 +191,14 @@ namespace sjtu {
              */
             iterator &operator--() {
                 if (if_end) {  //是end 指针
-                    ptr = this_map->root;
-                    if (ptr == nullptr) throw invalid_iterator();
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
+                    if (this_map->rightmost == nullptr) throw invalid_iterator();
+                    ptr = this_map->rightmost;
                     if_end = false; //不再是end迭代器了
                     return *this;
                 }
-                if (ptr->lson == nullptr) {
-                    if (ptr->dad == nullptr) {
-                        throw invalid_iterator(); //说明为迭代器begin;
-                    } else if (ptr == ptr->dad->lson) {
-                        node *temp = ptr;
-                        while (temp->dad != nullptr && temp == temp->dad->lson) {
-                            temp = temp->dad;
-                        }
-                        if (temp->dad == nullptr) {
-                            throw invalid_iterator(); //说明为迭代器begin;
-                        }
-                    }
-                }
-                if (ptr->lson != nullptr) { //找到左子树中最大的元素
-                    ptr = ptr->lson;
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                } else if (ptr == ptr->dad->rson) {  //已经排除了begin迭代器，保证了肯定有父节点
-                    ptr = ptr->dad;
-                } else {
-                    while (ptr == ptr->dad->lson) {
-                        ptr = ptr->dad;
-                    }
-                    ptr = ptr->dad;
-                }
+                node *pre = predecessor(ptr);
+                if (pre == nullptr) throw invalid_iterator(); //说明为迭代器begin;
+                ptr = pre;
                 return *this;
             }
 
@@ -280,29 +266,8 @@ namespace sjtu {
             const_iterator(const iterator &other) : ptr(other.ptr), this_map(other.this_map), if_end(other.if_end) {}
 
             const_iterator operator++(int) {
-                if (if_end) throw invalid_iterator();
                 const_iterator iter(*this);
-                if (ptr->rson != nullptr) {  //先找右子树中最小的那个
-                    ptr = ptr->rson;
-                    while (ptr->lson != nullptr) ptr = ptr->lson;
-                } else {  //没有右子树
-                    if (ptr->dad == nullptr) {
-                        if_end = true;  //变为迭代器end()
-                        ptr = nullptr;
-                    } else if (ptr == ptr->dad->rson) {
-                        while (ptr->dad != nullptr && ptr == ptr->dad->rson) {
-                            ptr = ptr->dad;
-                        }
-                        if (ptr->dad == nullptr) {
-                            if_end = true;
-                            ptr = nullptr;
-                        } else {
-                            ptr = ptr->dad;
-                        }
-                    } else {
-                        ptr = ptr->dad;
-                    }
-                }
+                ++*this;
                 return iter;
             }
 
@@ -311,27 +276,8 @@ namespace sjtu {
              */
             const_iterator &operator++() {
                 if (if_end) throw invalid_iterator();
-                if (ptr->rson != nullptr) {  //先找右子树中最小的那个
-                    ptr = ptr->rson;
-                    while (ptr->lson != nullptr) ptr = ptr->lson;
-                } else {  //没有右子树
-                    if (ptr->dad == nullptr) { //已经是最大的节点了
-                        if_end = true;  //变为迭代器end()
-                        ptr = nullptr;
-                    } else if (ptr == ptr->dad->rson) {  //是父节点的右儿子
-                        while (ptr->dad != nullptr && ptr == ptr->dad->rson) {
-                            ptr = ptr->dad;
-                        }
-                        if (ptr->dad == nullptr) { //已经是最大的节点了
-                            if_end = true;
-                            ptr = nullptr;
-                        } else {
-                            ptr = ptr->dad;
-                        }
-                    } else {
-                        ptr = ptr->dad;
-                    }
-                }
+                ptr = successor(ptr);
+                if (ptr == nullptr) if_end = true;  //已经是最大的节点了，变为迭代器end()
                 return *this;
             }
 
@@ -342,37 +288,7 @@ namespace sjtu {
 
             const_iterator operator--(int) {
                 const_iterator iter(*this);
-                if (if_end) {  //是end 指针
-                    ptr = this_map->root;
-                    if (ptr == nullptr) throw invalid_iterator();
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                    if_end = false; //不再是end迭代器了
-                    return iter;
-                }
-                if (ptr->lson == nullptr) {
-                    if (ptr->dad == nullptr) {
-                        throw invalid_iterator(); //说明为迭代器begin;
-                    } else if (ptr == ptr->dad->lson) {
-                        const node *temp = ptr;
-                        while (temp->dad != nullptr && temp == temp->dad->lson) {
-                            temp = temp->dad;
-                        }
-                        if (temp->dad == nullptr) {
-                            throw invalid_iterator(); //说明为迭代器begin;
-                        }
-                    }
-                }
-                if (ptr->lson != nullptr) { //找到左子树中最大的元素
-                    ptr = ptr->lson;
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                } else if (ptr == ptr->dad->rson) {  //已经排除了begin迭代器，保证了肯定有父节点
-                    ptr = ptr->dad;
-                } else {
-                    while (ptr == ptr->dad->lson) {
-                        ptr = ptr->dad;
-                    }
-                    ptr = ptr->dad;
-                }
+                --*this;
                 return iter;
             }
 
@@ -381,36 +297,14 @@ namespace sjtu {
              */
             const_iterator &operator--() {
                 if (if_end) {  //是end 指针
-                    ptr = this_map->root;
-                    if (ptr == nullptr) throw invalid_iterator();
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
+                    if (this_map->rightmost == nullptr) throw invalid_iterator();
+                    ptr = this_map->rightmost;
                     if_end = false; //不再是end迭代器了
                     return *this;
                 }
-                if (ptr->lson == nullptr) {
-                    if (ptr->dad == nullptr) {
-                        throw invalid_iterator(); //说明为迭代器begin;
-                    } else if (ptr == ptr->dad->lson) {
-                        const node *temp = ptr;
-                        while (temp->dad != nullptr && temp == temp->dad->lson) {
-                            temp = temp->dad;
-                        }
-                        if (temp->dad == nullptr) {
-                            throw invalid_iterator(); //说明为迭代器begin;
-                        }
-                    }
-                }
-                if (ptr->lson != nullptr) { //找到左子树中最大的元素
-                    ptr = ptr->lson;
-                    while (ptr->rson != nullptr) ptr = ptr->rson;
-                } else if (ptr == ptr->dad->rson) {  //已经排除了begin迭代器，保证了肯定有父节点
-                    ptr = ptr->dad;
-                } else {
-                    while (ptr == ptr->dad->lson) {
-                        ptr = ptr->dad;
-                    }
-                    ptr = ptr->dad;
-                }
+                const node *pre = predecessor(ptr);
+                if (pre == nullptr) throw invalid_iterator(); //说明为迭代器begin;
+                ptr = pre;
                 return *this;
             }
 
@@ -454,28 +348,70 @@ namespace sjtu {
         };
 
 
-        map() {
+        map() : map(Compare()) {}
+
+        /**
+         * an empty map ordered by comp, which may carry state (e.g. a runtime-chosen ordering).
+         */
+        explicit map(const Compare &comp, const Allocator &alloc = Allocator())
+                : map_key_compare<Compare>(comp), slab_alloc(alloc) {
             root = nullptr;
             ele_size = 0;
         }
 
-        map(const map &other) {
+        explicit map(const Allocator &alloc) : map(Compare(), alloc) {}
+
+        map(const map &other)
+                : map_key_compare<Compare>(other.comp()),
+                  slab_alloc(slab_alloc_traits::select_on_container_copy_construction(other.slab_alloc)) {
             root = nullptr;
-            creat(root, other.root);
+            try {
+                creat(root, other.root);
+            } catch (...) {
+                release_slabs();
+                throw;
+            }
+            reset_ends();
             ele_size = other.ele_size;
         }
 
+        /**
+         * builds the map from the elements in [first, last).
+         * the elements are sorted first, then the tree is built in one linear pass.
+         * for equal keys only the first one is kept, like insert().
+         */
+        template<class InputIterator>
+        map(InputIterator first, InputIterator last, const Compare &comp = Compare(),
+            const Allocator &alloc = Allocator()) : map(comp, alloc) {
+            assign(first, last);
+        }
+
+        /**
+         * builds the map from [first, last), which is already sorted by key, in O(n).
+         * throw runtime_error if the range is not sorted.
+         */
+        template<class InputIterator>
+        map(sorted_unique_t, InputIterator first, InputIterator last, const Compare &comp = Compare(),
+            const Allocator &alloc = Allocator()) : map(comp, alloc) {
+            assign_sorted(first, last);
+        }
+
         map &operator=(const map &other) {
             if (this == &other) return *this;
+            static_cast<map_key_compare<Compare> &>(*this) = other;  //比较器也一起复制
             clear(root);
             root = nullptr;
+            ele_size = 0;
+            reset_ends();
             creat(root, other.root);
+            reset_ends();
             ele_size = other.ele_size;
             return *this;
         }
 
         ~map() {
             clear(root);
+            release_slabs();
         }
 
         /**
@@ -496,6 +432,24 @@ namespace sjtu {
             else return ptr->data.second;
         }
 
+        /**
+         * at() for any type K comparable with Key, without constructing a Key.
+         * only available when Compare::is_transparent exists (e.g. std::less<>).
+         */
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        T &at(const K &key) {
+            node *ptr = find(key, root);
+            if (ptr == nullptr) throw index_out_of_bound();
+            else return ptr->data.second;
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        const T &at(const K &key) const {
+            node *ptr = find(key, root);
+            if (ptr == nullptr) throw index_out_of_bound();
+            else return ptr->data.second;
+        }
+
         /**
          * TODO
          * access specified element
@@ -503,11 +457,7 @@ namespace sjtu {
          *   performing an insertion if such key does not already exist.
          */
         T &operator[](const Key &key) {
-            node *ptr = find(key, root);
-            if (ptr != nullptr) return ptr->data.second;
-            bool flag;
-            ++ele_size;
-            return (insert(value_type(key, T()), root, flag)->data.second);
+            return try_emplace(key).first->second;
         }
 
         /**
@@ -526,18 +476,14 @@ namespace sjtu {
             if (ele_size == 0) { // map为空时，begin==end
                 return iterator(nullptr, this, true);
             }
-            node *ptr = root;
-            while (ptr->lson != nullptr) ptr = ptr->lson;
-            return iterator(ptr, this, false);
+            return iterator(leftmost, this, false);
         }
 
         const_iterator cbegin() const {  //常量成员函数的声明const会导致传出的this指针是一个常量指针
             if (ele_size == 0) { // map为空时，begin==end
                 return const_iterator(nullptr, this, true);
             }
-            node *ptr = root;
-            while (ptr->lson != nullptr) ptr = ptr->lson;
-            return const_iterator(ptr, this, false);
+            return const_iterator(leftmost, this, false);
         }
 
         /**
@@ -552,6 +498,42 @@ namespace sjtu {
             return const_iterator(nullptr, this, true);
         }
 
+        /**
+         * returns the comparator ordering the keys.
+         */
+        key_compare key_comp() const {
+            return comp();
+        }
+
+        /**
+         * returns a comparator ordering value_type objects by key.
+         */
+        value_compare value_comp() const {
+            return value_compare(comp());
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return allocator_type(slab_alloc);
+        }
+
+        /**
+         * number of slabs the nodes are carved from.
+         * slabs are kept by clear() and erase() and only given back on destruction.
+         */
+        size_t slab_count() const {
+            return slab_num;
+        }
+
+        /**
+         * number of node slots waiting in the free list for the next insertion.
+         */
+        size_t free_node_count() const {
+            return free_num;
+        }
+
         /**
          * checks whether the container is empty
          * return true if empty, otherwise false.
@@ -574,6 +556,50 @@ namespace sjtu {
             clear(root);
             ele_size = 0;
             root = nullptr;
+            reset_ends();
+        }
+
+        /**
+         * replaces the contents with the elements in [first, last), which must be sorted by key.
+         * builds a perfectly balanced tree in O(n) without any rotation.
+         * for equal keys only the first one is kept.
+         * throw runtime_error if the range is not sorted, the map is then left unchanged.
+         */
+        template<class InputIterator>
+        void assign_sorted(InputIterator first, InputIterator last) {
+            size_t n = 0;
+            node *head = make_chain(first, last, n);
+            bool sorted;
+            try {
+                sorted = unique_chain(head, n);
+            } catch (...) {
+                clear_chain(head);
+                throw;
+            }
+            if (!sorted) {
+                clear_chain(head);
+                throw runtime_error();
+            }
+            build_from_chain(head, n);
+        }
+
+        /**
+         * replaces the contents with the elements in [first, last) in any order.
+         * the elements are merge sorted in O(nlogn), then the tree is built in O(n).
+         * for equal keys only the first one is kept.
+         */
+        template<class InputIterator>
+        void assign(InputIterator first, InputIterator last) {
+            size_t n = 0;
+            node *head = make_chain(first, last, n);
+            try {
+                sort_chain(head, n);
+                unique_chain(head, n);
+            } catch (...) {
+                clear_chain(head);
+                throw;
+            }
+            build_from_chain(head, n);
         }
 
         /**
@@ -584,12 +610,39 @@ namespace sjtu {
          */
         pair<iterator, bool> insert(const value_type &value) {
             bool flag;
-            node *a = insert(value, root, flag);
+            node *a = insert(value.first, flag, value, 1, nullptr, nullptr, nullptr);
             iterator iter(a, this, false);
             if (flag) ++ele_size;  //插入成功，元素数加一
             return pair<iterator, bool>(iter, flag);
         }
 
+        /**
+         * inserts an element with key and a value constructed from args if key does not exist,
+         *   otherwise does nothing (args are not touched).
+         * only one walk from the root is made either way.
+         * the return value is the same as insert().
+         */
+        template<class... Args>
+        pair<iterator, bool> try_emplace(const Key &key, Args &&... args) {
+            bool flag;
+            node *a = insert(key, flag, nullptr, key, std::forward<Args>(args)...);
+            if (flag) ++ele_size;
+            return pair<iterator, bool>(iterator(a, this, false), flag);
+        }
+
+        /**
+         * inserts (key, obj) if key does not exist, otherwise assigns obj to the existing value.
+         * the second of the return value is true if an insertion took place.
+         */
+        template<class M>
+        pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+            bool flag;
+            node *a = insert(key, flag, nullptr, key, std::forward<M>(obj));
+            if (flag) ++ele_size;
+            else a->data.second = std::forward<M>(obj);
+            return pair<iterator, bool>(iterator(a, this, false), flag);
+        }
+
         /**
          * erase the element at pos.
          *
@@ -597,7 +650,7 @@ namespace sjtu {
          */
         void erase(iterator pos) {
             if (pos.if_end || pos.this_map != this) throw invalid_iterator();
-            erase(root, pos.ptr);
+            erase(pos.ptr);
             --ele_size;
         }
 
@@ -613,6 +666,12 @@ namespace sjtu {
             return 0;
         }
 
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        size_t count(const K &key) const {
+            if (find(key, root) != nullptr) return 1;
+            return 0;
+        }
+
         /**
          * Finds an element with key equivalent to key.
          * key value of the element to search for.
@@ -631,36 +690,348 @@ namespace sjtu {
             return const_iterator(result, this, false);
         }
 
+        /**
+         * find() for any type K comparable with Key, e.g. a const char * in a map<std::string, T, std::less<>>.
+         * only available when Compare::is_transparent exists.
+         */
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        iterator find(const K &key) {
+            node *result = find(key, root);
+            if (result == nullptr) return end();
+            return iterator(result, this, false);
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        const_iterator find(const K &key) const {
+            node *result = find(key, root);
+            if (result == nullptr) return cend();
+            return const_iterator(result, this, false);
+        }
+
+        /**
+         * returns an iterator to the first element whose key is not less than key,
+         *   or end() if there is no such element.
+         */
+        iterator lower_bound(const Key &key) {
+            node *result = lower_bound_node(key);
+            if (result == nullptr) return end();
+            return iterator(result, this, false);
+        }
+
+        const_iterator lower_bound(const Key &key) const {
+            node *result = lower_bound_node(key);
+            if (result == nullptr) return cend();
+            return const_iterator(result, this, false);
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        iterator lower_bound(const K &key) {
+            node *result = lower_bound_node(key);
+            if (result == nullptr) return end();
+            return iterator(result, this, false);
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        const_iterator lower_bound(const K &key) const {
+            node *result = lower_bound_node(key);
+            if (result == nullptr) return cend();
+            return const_iterator(result, this, false);
+        }
+
+        /**
+         * returns an iterator to the first element whose key is greater than key,
+         *   or end() if there is no such element.
+         */
+        iterator upper_bound(const Key &key) {
+            node *result = upper_bound_node(key);
+            if (result == nullptr) return end();
+            return iterator(result, this, false);
+        }
+
+        const_iterator upper_bound(const Key &key) const {
+            node *result = upper_bound_node(key);
+            if (result == nullptr) return cend();
+            return const_iterator(result, this, false);
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        iterator upper_bound(const K &key) {
+            node *result = upper_bound_node(key);
+            if (result == nullptr) return end();
+            return iterator(result, this, false);
+        }
+
+        template<class K, class C = Compare, class = typename C::is_transparent>
+        const_iterator upper_bound(const K &key) const {
+            node *result = upper_bound_node(key);
+            if (result == nullptr) return cend();
+            return const_iterator(result, this, false);
+        }
+
     private:
+        //节点不是一个个单独向分配器申请的，而是成块(slab)地申请，被删除的节点放进空闲链表中等待复用。
+        union node_slot {
+            node_slot *next;  //在空闲链表中时指向下一个空闲位置
+            alignas(node) unsigned char data[sizeof(node)];
+        };
+
+        static constexpr size_t slab_nodes = (4096 / sizeof(node_slot) > 16) ? 4096 / sizeof(node_slot) : 16;
+
+        struct slab {
+            slab *next;
+            node_slot slots[slab_nodes];
+        };
+
+        using slab_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slab>;
+        using slab_alloc_traits = std::allocator_traits<slab_allocator>;
+
         node *root = nullptr;
+        node *leftmost = nullptr;   //最小的节点，即begin()
+        node *rightmost = nullptr;  //最大的节点，即--end()
         size_t ele_size = 0;
+        slab_allocator slab_alloc;  //所有节点所在的slab都从这个分配器中申请
+        slab *slabs = nullptr;
+        node_slot *free_list = nullptr;
+        size_t slab_num = 0;
+        size_t free_num = 0;
+
+        void new_slab() {
+            slab *s = slab_alloc_traits::allocate(slab_alloc, 1);
+            s->next = slabs;
+            slabs = s;
+            ++slab_num;
+            for (size_t i = slab_nodes; i > 0; --i) {  //倒序放入，使得先取出的节点地址更小
+                s->slots[i - 1].next = free_list;
+                free_list = &s->slots[i - 1];
+            }
+            free_num += slab_nodes;
+        }
+
+        void release_slabs() {  //调用时所有节点必须都已经被销毁
+            while (slabs != nullptr) {
+                slab *next = slabs->next;
+                slab_alloc_traits::deallocate(slab_alloc, slabs, 1);
+                slabs = next;
+            }
+            free_list = nullptr;
+            slab_num = 0;
+            free_num = 0;
+        }
+
+        template<class... Args>
+        node *create_node(Args &&... args) {
+            if (free_list == nullptr) new_slab();
+            node_slot *slot = free_list;
+            node_slot *next = slot->next;  //构造节点会覆盖掉next
+            node *p = reinterpret_cast<node *>(slot->data);
+            try {
+                ::new(static_cast<void *>(p)) node(std::forward<Args>(args)...);
+            } catch (...) {
+                slot->next = next;  //构造失败时slot仍留在空闲链表中
+                throw;
+            }
+            free_list = next;
+            --free_num;
+            return p;
+        }
+
+        void destroy_node(node *p) {
+            p->~node();
+            node_slot *slot = reinterpret_cast<node_slot *>(p);
+            slot->next = free_list;
+            free_list = slot;
+            ++free_num;
+        }
+
+        //批量建树时，节点先用rson串成一条链表，lson为空。
+        template<class InputIterator>
+        node *make_chain(InputIterator first, InputIterator last, size_t &n) {
+            node *head = nullptr, *tail = nullptr;
+            try {
+                for (; first != last; ++first) {
+                    node *p = create_node(*first, 1, nullptr, nullptr, nullptr);
+                    if (tail == nullptr) head = p;
+                    else tail->rson = p;
+                    tail = p;
+                    ++n;
+                }
+            } catch (...) {
+                clear_chain(head);
+                throw;
+            }
+            return head;
+        }
+
+        void clear_chain(node *head) {
+            while (head != nullptr) {
+                node *next = head->rson;
+                destroy_node(head);
+                head = next;
+            }
+        }
+
+        //链表上的归并排序，相等的键保持原来的先后顺序。n为链表长度。
+        //比较抛出异常时head仍是包含全部n个节点的链表，由调用者释放。
+        void sort_chain(node *&head, size_t n) {
+            if (n <= 1) return;
+            node *mid = head;
+            for (size_t i = 1; i < n / 2; ++i) mid = mid->rson;
+            node *right = mid->rson;
+            mid->rson = nullptr;
+            node *merged = nullptr, **tail = &merged;  //tail指向链表末尾的rson
+            try {
+                sort_chain(head, n / 2);
+                sort_chain(right, n - n / 2);
+                while (head != nullptr && right != nullptr) {
+                    if (comp()(right->data.first, head->data.first)) {
+                        *tail = right;
+                        right = right->rson;
+                    } else {
+                        *tail = head;
+                        head = head->rson;
+                    }
+                    tail = &(*tail)->rson;
+                }
+            } catch (...) {  //把已归并的部分和两段剩余部分重新接成一条链表
+                *tail = head;
+                while (*tail != nullptr) tail = &(*tail)->rson;
+                *tail = right;
+                head = merged;
+                throw;
+            }
+            *tail = (head != nullptr) ? head : right;
+            head = merged;
+        }
+
+        //删除有序链表中键相等的后继节点，n随之更新。链表无序时返回false。
+        bool unique_chain(node *head, size_t &n) {
+            if (head == nullptr) return true;
+            node *p = head;
+            while (p->rson != nullptr) {
+                node *next = p->rson;
+                if (comp()(next->data.first, p->data.first)) return false;
+                if (!comp()(p->data.first, next->data.first)) {  //键相等，保留前一个
+                    p->rson = next->rson;
+                    destroy_node(next);
+                    --n;
+                } else {
+                    p = next;
+                }
+            }
+            return true;
+        }
+
+        //用长度为n的有序链表替换整棵树
+        void build_from_chain(node *head, size_t n) {
+            clear(root);
+            root = build(head, n);
+            if (root != nullptr) root->dad = nullptr;
+            reset_ends();
+            ele_size = n;
+        }
 
-        void creat(node *&_root, node *o_root) {   //递归私有成员函数：将o_root的内容复制到root中。在调用create时，保证_root为空指针。
+        //用链表cur开头的n个节点中序建出一棵完全平衡的树，cur移动到第n+1个节点。
+        node *build(node *&cur, size_t n) {
+            if (n == 0) return nullptr;
+            node *l = build(cur, n / 2);
+            node *r = cur;
+            cur = cur->rson;
+            r->lson = l;
+            if (l != nullptr) l->dad = r;
+            r->rson = build(cur, n - n / 2 - 1);
+            if (r->rson != nullptr) r->rson->dad = r;
+            r->height = max(height(r->lson), height(r->rson)) + 1;
+            return r;
+        }
+
+        //将o_root的内容复制到_root中。在调用creat时，保证_root为空指针。
+        //沿着dad指针在两棵树上同步走，不需要递归或额外的栈；中途失败时已复制的部分会被释放。
+        void creat(node *&_root, node *o_root) {
             if (o_root == nullptr) return;
-            _root = new node(o_root->data, o_root->height, nullptr, nullptr, nullptr);
-            if (o_root->lson != nullptr) {
-                creat(_root->lson, o_root->lson);
-                _root->lson->dad = _root;
+            _root = create_node(o_root->data, o_root->height, nullptr, nullptr, nullptr);
+            node *src = o_root, *dst = _root;
+            try {
+                while (true) {
+                    if (src->lson != nullptr && dst->lson == nullptr) {
+                        dst->lson = create_node(src->lson->data, src->lson->height, nullptr, nullptr, dst);
+                        src = src->lson;
+                        dst = dst->lson;
+                    } else if (src->rson != nullptr && dst->rson == nullptr) {
+                        dst->rson = create_node(src->rson->data, src->rson->height, nullptr, nullptr, dst);
+                        src = src->rson;
+                        dst = dst->rson;
+                    } else {  //两个儿子都复制完了，回到父亲
+                        if (src == o_root) break;
+                        src = src->dad;
+                        dst = dst->dad;
+                    }
+                }
+            } catch (...) {
+                clear(_root);
+                _root = nullptr;
+                throw;
+            }
+        }
+
+        //清空以_root为根的整棵树（_root没有父亲）。每次删掉一个叶子后回到它的父亲，不需要递归。
+        void clear(node *_root) {
+            node *p = _root;
+            while (p != nullptr) {
+                if (p->lson != nullptr) {
+                    p = p->lson;
+                } else if (p->rson != nullptr) {
+                    p = p->rson;
+                } else {
+                    node *d = p->dad;
+                    if (d != nullptr) {
+                        if (d->lson == p) d->lson = nullptr;
+                        else d->rson = nullptr;
+                    }
+                    destroy_node(p);
+                    p = d;
+                }
             }
-            if (o_root->rson != nullptr) {
-                creat(_root->rson, o_root->rson);
-                _root->rson->dad = _root;
+        }
+
+        //从节点r开始寻找键值与key相等的节点,没找到就返回空指针。K可以是Key，也可以是透明比较器支持的其他类型。
+        template<class K>
+        node *find(const K &key, node *r) const {
+            while (r != nullptr) {
+                if (comp()(key, r->data.first)) r = r->lson;
+                else if (comp()(r->data.first, key)) r = r->rson;
+                else return r;
             }
+            return nullptr;
         }
 
-        void clear(node *_root) {    //递归私有成员函数：清空root的内容
-            if (_root == nullptr) return;
-            node *l = _root->lson;
-            node *r = _root->rson;
-            delete _root;
-            clear(l);
-            clear(r);
+        //第一个键不小于key的节点
+        template<class K>
+        node *lower_bound_node(const K &key) const {
+            node *r = root, *ret = nullptr;
+            while (r != nullptr) {
+                if (!comp()(r->data.first, key)) {
+                    ret = r;
+                    r = r->lson;
+                } else {
+                    r = r->rson;
+                }
+            }
+            return ret;
         }
 
-        node *find(const Key key, node *r) const {  //从节点r开始寻找键值key,没找到就返回空指针
-            if (r == nullptr || (!Compare()(key, r->data.first) && !Compare()(r->data.first, key))) return r; //为空节点或相等
-            if (Compare()(key, r->data.first)) return find(key, r->lson);
-            return find(key, r->rson);
+        //第一个键大于key的节点
+        template<class K>
+        node *upper_bound_node(const K &key) const {
+            node *r = root, *ret = nullptr;
+            while (r != nullptr) {
+                if (comp()(key, r->data.first)) {
+                    ret = r;
+                    r = r->lson;
+                } else {
+                    r = r->rson;
+                }
+            }
+            return ret;
         }
 
         int height(node *ptr) {  //返回节点的高度
@@ -706,144 +1077,197 @@ namespace sjtu {
             RR(a);
         }
 
-        node *insert(const value_type &data, node *&_root,
-                     bool &flag) {    //insert 作用与一个节点，表示将这个节点的插入全部完成（包括height的调整。）返回插入的节点指针(或者
-            node *ret;
-            if (_root == nullptr) {
-                _root = new node(data, 1, nullptr, nullptr, nullptr);
-                flag = true;
-                return _root;
-            } else if (!Compare()(_root->data.first, data.first) &&
-                       !Compare()(data.first, _root->data.first)) {  //出现重复元素
-                flag = false;
-                return _root;
-            } else if (Compare()(data.first, _root->data.first)) {  //插在左边
-                ret = insert(data, _root->lson, flag);
-                _root->lson->dad = _root;
-                if (height(_root->lson) - height(_root->rson) >= 2) { // 如果插入后左右子树高度差达到了2，那么肯定成功插入了，并且至少是插入在左（右）子树的儿子节点。
-                    if (Compare()(_root->lson->data.first, data.first)) {  //此为第一个失衡节点，它的子节点一定都是平衡的。
-                        LR(_root);
-                    } else {
-                        LL(_root);
-                    }
-                }
-            } else {
-                ret = insert(data, _root->rson, flag); //插在右边
-                _root->rson->dad = _root;
-                if (height(_root->rson) - height(_root->lson) >= 2) {
-                    if (Compare()(_root->rson->data.first, data.first)) {
-                        RR(_root);
-                    } else {
-                        RL(_root);
-                    }
-                }
+        const Compare &comp() const {
+            return map_key_compare<Compare>::get();
+        }
+
+        //只根据树的形状求中序遍历的后继/前驱，没有则返回空指针。
+        template<class N>
+        static N *tree_successor(N *p) {
+            if (p->rson != nullptr) {  //先找右子树中最小的那个
+                p = p->rson;
+                while (p->lson != nullptr) p = p->lson;
+                return p;
             }
-            _root->height = max(height(_root->lson), height(_root->rson)) + 1;
-            return ret;
+            while (p->dad != nullptr && p == p->dad->rson) p = p->dad;  //是父节点的右儿子
+            return p->dad;
         }
 
-        //在以结点r为根的树中删除节点target。返回值表示执行完毕以后，以r为根的树高度是否不变。
-        //必须要引用传递，否则调用adjust时，由于会用到LL()和RR()，都会失效
-        bool erase(node *&r, node *&target) {
-            if (r == nullptr) throw invalid_iterator();  //表示要删除的结点不存在，抛出异常
-            if (r == target) {
-                if (r->lson == nullptr || r->rson == nullptr) { // 被删除的节点是叶子节点或仅有一个儿子
-                    node *temp = (r->lson == nullptr) ? r->rson : r->lson;
-                    if (temp != nullptr) temp->dad = r->dad;
-                    node *tool = r; //为了删除r中元素而赋值的删除工具节点。由于r是引用传递的，所以不能把r直接删除掉。
-                    r = temp;
-                    delete tool; //必须把这个节点整个删掉,而不能仅仅是把值给替换了。因为指向这个结点的迭代器应该失效。
-                    return false; //删除完毕，树的高度发生了变化
-                } else {
-                    node *temp = r->rson;
-                    while (temp->lson != nullptr) temp = temp->lson;
-//                    if(r->dad != nullptr){  //必须把结点整个替换成temp，
-//                        if(r == r->dad->lson){
-//                            r->dad->lson = temp;
-//                        }else{
-//                            r->dad->rson = temp;
-//                        }
-//                    }else{
-//                        root = temp;
-//                    }
-                    node *temp_dad = temp->dad, *temp_rson = temp->rson;
-                    int temp_height = temp->height;
-                    //为了防止出现指针循环无穷指的情况，应该将r和temp交换，而不是直接让temp指针取代r的位置。
-                    //注意分类讨论，用于替换的节点temp是否就是r的右儿子。如果是的话，直接交换两个节点即可。
-                    if (r->rson == temp) {
-                        temp->dad = r->dad;
-                        temp->lson = r->lson;
-                        r->lson->dad = temp;
-                        temp->rson = r;
-                        temp->height = r->height;
-                        r->dad = temp;
-                        r->lson = nullptr;
-                        r->rson = temp_rson;
-                        if (temp_rson != nullptr) temp_rson->dad = r;
-                        r->height = temp_height;
-                    } else {
-                        temp->dad = r->dad;
-                        r->lson->dad = temp;
-                        r->rson->dad = temp;
-                        temp->rson = r->rson;
-                        temp->lson = r->lson;
-                        temp->height = r->height;
-                        r->lson = nullptr;
-                        r->rson = temp_rson;
-                        if (temp_rson != nullptr) temp_rson->dad = r;
-                        temp_dad->lson = r;
-                        r->dad = temp_dad;
-                        r->height = temp_height;
-                    }
-                    node *tmp = r; //tmp用于删除
-                    r = temp;
-                    if (erase(r->rson, tmp)) return true; //删除以后，右子树的高度未变
-                    return adjust(r, true);
+        template<class N>
+        static N *tree_predecessor(N *p) {
+            if (p->lson != nullptr) {  //找到左子树中最大的元素
+                p = p->lson;
+                while (p->rson != nullptr) p = p->rson;
+                return p;
+            }
+            while (p->dad != nullptr && p == p->dad->lson) p = p->dad;
+            return p->dad;
+        }
+
+        //线索化时直接沿线索走，O(1)
+        template<class N>
+        static N *successor(N *p) {
+            if constexpr (Threaded) return p->next;
+            else return tree_successor(p);
+        }
+
+        template<class N>
+        static N *predecessor(N *p) {
+            if constexpr (Threaded) return p->prev;
+            else return tree_predecessor(p);
+        }
+
+        //整棵树重建以后重新求出leftmost和rightmost，线索化时顺便把所有线索接好。
+        void reset_ends() {
+            if (root == nullptr) {
+                leftmost = rightmost = nullptr;
+                return;
+            }
+            leftmost = root;
+            while (leftmost->lson != nullptr) leftmost = leftmost->lson;
+            rightmost = root;
+            while (rightmost->rson != nullptr) rightmost = rightmost->rson;
+            if constexpr (Threaded) {
+                node *prev = nullptr;
+                for (node *p = leftmost; p != nullptr; p = tree_successor(p)) {
+                    p->prev = prev;
+                    if (prev != nullptr) prev->next = p;
+                    prev = p;
                 }
-            } else if (Compare()(r->data.first, target->data.first)) { //在右子树上删除
-                if (erase(r->rson, target)) return true; //在右子树上删完后，右子树高度不变
-                return adjust(r, true); //尝试对结点r进行调整
-            } else {
-                if (erase(r->lson, target)) return true;
-                return adjust(r, false);
+                rightmost->next = nullptr;
             }
         }
 
-        bool adjust(node *&r, bool flag) {  //r节点的flag ? 右 ： 左子树高度减一，需要对r节点进行调整。返回调整后高度是否回到了本来的值。
-            if (flag) {
-                if (height(r->lson) == height(r->rson)) {
-                    --r->height;
-                    return false;
-                } else if (height(r->lson) - height(r->rson) == 1) {
-                    return true;
+        //指向节点p的那个指针（父亲的lson/rson，或者root）。旋转函数通过它把新的子树根接回去。
+        node *&link_of(node *p) {
+            if (p->dad == nullptr) return root;
+            return (p == p->dad->lson) ? p->dad->lson : p->dad->rson;
+        }
+
+        //插入键为key的节点，返回插入的节点指针(或者已存在的键为key的节点)，flag表示是否插入成功。
+        //只有key不存在时才会用args构造新节点，args即为node构造函数的参数。
+        //从根往下走一次找到插入位置，再沿dad指针向上调整，子树高度不变时即可停止。
+        template<class... Args>
+        node *insert(const Key &key, bool &flag, Args &&... args) {
+            node *parent = nullptr;
+            node **link = &root;
+            while (*link != nullptr) {
+                node *cur = *link;
+                if (comp()(key, cur->data.first)) {
+                    parent = cur;
+                    link = &cur->lson;
+                } else if (comp()(cur->data.first, key)) {
+                    parent = cur;
+                    link = &cur->rson;
+                } else {  //出现重复元素
+                    flag = false;
+                    return cur;
                 }
-                if (r->lson != nullptr && height(r->lson->lson) == height(r->lson->rson) + 1) {
-                    LL(r);  //LL函数也完成了修改结点高度
-                    return false; //树的高度-1
+            }
+            node *ret = create_node(std::forward<Args>(args)...);
+            ret->dad = parent;
+            *link = ret;
+            flag = true;
+            if (parent == nullptr) {
+                leftmost = rightmost = ret;
+            } else if (link == &parent->lson) {  //新节点是父亲在中序遍历中的前驱
+                if (parent == leftmost) leftmost = ret;
+                if constexpr (Threaded) {
+                    ret->next = parent;
+                    ret->prev = parent->prev;
+                    if (ret->prev != nullptr) ret->prev->next = ret;
+                    parent->prev = ret;
                 }
-                if (r->lson != nullptr && height(r->lson->lson) == height(r->lson->rson) - 1) {
-                    LR(r);
-                    return false; //树的高度-1
+            } else {  //新节点是父亲在中序遍历中的后继
+                if (parent == rightmost) rightmost = ret;
+                if constexpr (Threaded) {
+                    ret->prev = parent;
+                    ret->next = parent->next;
+                    if (ret->next != nullptr) ret->next->prev = ret;
+                    parent->next = ret;
                 }
-                LL(r);
-                return true;
-            } else {
-                if (height(r->lson) == height(r->rson)) {
-                    --r->height;
-                    return false;
-                } else if (height(r->rson) - height(r->lson) == 1) {
-                    return true;
+            }
+            for (node *p = parent; p != nullptr; p = p->dad) {
+                int lh = height(p->lson), rh = height(p->rson);
+                if (lh - rh >= 2) {  //第一个失衡节点，旋转后子树高度回到插入前，不必再往上调整
+                    if (height(p->lson->lson) >= height(p->lson->rson)) LL(link_of(p));
+                    else LR(link_of(p));
+                    break;
                 }
-                if (r->rson != nullptr && height(r->rson->rson) == height(r->rson->lson) + 1) {
-                    RR(r);
-                    return false;
+                if (rh - lh >= 2) {
+                    if (height(p->rson->rson) >= height(p->rson->lson)) RR(link_of(p));
+                    else RL(link_of(p));
+                    break;
                 }
-                if (r->rson != nullptr && height(r->rson->rson) == height(r->rson->lson) - 1) {
-                    RL(r);
-                    return false;
+                int h = max(lh, rh) + 1;
+                if (h == p->height) break;  //高度未变，上面的节点都不受影响
+                p->height = h;
+            }
+            return ret;
+        }
+
+        //把有两个儿子的节点t和它的后继s(t右子树中最小的节点)在树中的位置互换。
+        //必须交换节点本身而不是交换值，因为指向s的迭代器不能失效，而且键是const的。
+        void swap_with_successor(node *t, node *s) {
+            node *s_dad = s->dad, *s_rson = s->rson;  //s没有左儿子
+            int s_height = s->height;
+            link_of(t) = s;
+            s->dad = t->dad;
+            s->lson = t->lson;
+            t->lson->dad = s;
+            if (s_dad == t) {  //s就是t的右儿子
+                s->rson = t;
+                t->dad = s;
+            } else {
+                s->rson = t->rson;
+                t->rson->dad = s;
+                s_dad->lson = t;
+                t->dad = s_dad;
+            }
+            s->height = t->height;
+            t->lson = nullptr;
+            t->rson = s_rson;
+            if (s_rson != nullptr) s_rson->dad = t;
+            t->height = s_height;
+        }
+
+        //删除节点target。通过dad指针直接定位，然后从被删位置沿dad指针向上调整，子树高度不变时即可停止。
+        void erase(node *target) {
+            if (target == leftmost) leftmost = successor(target);
+            if (target == rightmost) rightmost = predecessor(target);
+            if constexpr (Threaded) {
+                if (target->prev != nullptr) target->prev->next = target->next;
+                if (target->next != nullptr) target->next->prev = target->prev;
+            }
+            if (target->lson != nullptr && target->rson != nullptr) {
+                node *s = target->rson;
+                while (s->lson != nullptr) s = s->lson;
+                swap_with_successor(target, s);
+            }
+            node *child = (target->lson != nullptr) ? target->lson : target->rson;  //此时target至多有一个儿子
+            node *p = target->dad;
+            link_of(target) = child;
+            if (child != nullptr) child->dad = p;
+            destroy_node(target); //必须把这个节点整个删掉,而不能仅仅是把值给替换了。因为指向这个结点的迭代器应该失效。
+            while (p != nullptr) {
+                node *next = p->dad;  //旋转后新子树根的父亲仍是next
+                int old_height = p->height;
+                int lh = height(p->lson), rh = height(p->rson);
+                if (lh - rh >= 2) {
+                    node *&link = link_of(p);
+                    if (height(p->lson->lson) >= height(p->lson->rson)) LL(link);
+                    else LR(link);
+                    p = link;
+                } else if (rh - lh >= 2) {
+                    node *&link = link_of(p);
+                    if (height(p->rson->rson) >= height(p->rson->lson)) RR(link);
+                    else RL(link);
+                    p = link;
+                } else {
+                    p->height = max(lh, rh) + 1;
                 }
-                RR(r);
-                return true;
+                if (p->height == old_height) break;  //子树高度未变，上面的节点都不受影响
+                p = next;
             }
         }
     };
@@ -0,0 +1,38 @@
+#ifndef SJTU_UTILITY_HPP
+#define SJTU_UTILITY_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace sjtu {
+
+template<class T1, class T2>
+class pair {
+public:
+	T1 first;
+	T2 second;
+	constexpr pair() : first(), second() {}
+	pair(const pair &other) = default;
+	pair(pair &&other) = default;
+	pair(const T1 &x, const T2 &y) : first(x), second(y) {}
+	template<class U1, class U2>
+	pair(U1 &&x, U2 &&y) : first(x), second(y) {}
+	template<class U1, class U2>
+	pair(const pair<U1, U2> &other) : first(other.first), second(other.second) {}
+	template<class U1, class U2>
+	pair(pair<U1, U2> &&other) : first(other.first), second(other.second) {}
+	// first由args1构造，second由args2构造，都是原地构造，不经过临时对象
+	template<class... Args1, class... Args2>
+	pair(std::piecewise_construct_t, std::tuple<Args1...> args1, std::tuple<Args2...> args2)
+		: pair(args1, args2, std::index_sequence_for<Args1...>(), std::index_sequence_for<Args2...>()) {}
+
+private:
+	template<class... Args1, class... Args2, std::size_t... I1, std::size_t... I2>
+	pair(std::tuple<Args1...> &args1, std::tuple<Args2...> &args2, std::index_sequence<I1...>, std::index_sequence<I2...>)
+		: first(std::forward<Args1>(std::get<I1>(args1))...), second(std::forward<Args2>(std::get<I2>(args2))...) {}
+};
+
+}
+
+#endif
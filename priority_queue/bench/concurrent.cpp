@@ -0,0 +1,81 @@
+// compare sjtu::concurrent_priority_queue with a priority_queue behind one global mutex.
+// not part of the test suite, build it by hand with optimization, e.g.
+//     g++ -std=c++17 -O2 -pthread -I../src concurrent.cpp -o concurrent && ./concurrent
+// every thread does ops operations, half pushes and half pops, on a queue prefilled with n keys.
+// the table shows the total throughput in million operations per second for 1 to 64 threads,
+//     so it only shows scaling on a machine with that many cores.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "concurrent_priority_queue.hpp"
+#include "priority_queue.hpp"
+
+namespace {
+
+    struct global_lock_queue {
+        std::mutex lock;
+        sjtu::priority_queue<int> q;
+
+        void push(int x) {
+            std::lock_guard<std::mutex> guard(lock);
+            q.push(x);
+        }
+
+        bool try_pop(int &out) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (q.empty()) return false;
+            out = q.top();
+            q.pop();
+            return true;
+        }
+    };
+
+    std::atomic<long long> sink;
+
+    template<class Q>
+    double run(Q &q, size_t threads, size_t n, size_t ops) {
+        for (size_t i = 0; i < n; ++i) q.push(static_cast<int>(i * 2654435761u));
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&q, t, ops] {
+                std::mt19937 rng(static_cast<unsigned>(t + 1));
+                long long sum = 0;
+                int x;
+                for (size_t i = 0; i < ops; ++i) {
+                    if (i % 2 == 0) q.push(static_cast<int>(rng()));
+                    else if (q.try_pop(x)) sum += x;
+                }
+                sink += sum;
+            });
+        }
+        for (auto &w : workers) w.join();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(threads * ops) / ms / 1000.0;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t ops = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    std::printf("prefill = %zu, ops per thread = %zu, hardware threads = %u, Mops/s\n",
+                n, ops, std::thread::hardware_concurrency());
+    std::printf("%-8s %12s %12s %12s\n", "threads", "global-lock", "relaxed", "strict");
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        global_lock_queue global;
+        sjtu::concurrent_priority_queue<int> relaxed(2 * threads, sjtu::queue_order::relaxed);
+        sjtu::concurrent_priority_queue<int> strict(2 * threads, sjtu::queue_order::strict);
+        double a = run(global, threads, n, ops);
+        double b = run(relaxed, threads, n, ops);
+        double c = run(strict, threads, n, ops);
+        std::printf("%-8zu %12.2f %12.2f %12.2f\n", threads, a, b, c);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+// compare the heap engines behind sjtu::priority_queue.
+// not part of the test suite, build it by hand with optimization, e.g.
+//     g++ -std=c++17 -O2 -I../src engines.cpp -o engines && ./engines
+// workloads:
+//     push-heavy : push n random keys, then pop them all
+//     steady     : keep n keys, then pop one and push one, 4n times
+//     merge-heavy: n/16 queues of 16 keys merged into one, then pop them all
+//     range      : build from a range of n keys, then pop them all
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "priority_queue.hpp"
+
+namespace {
+
+    template<class Policy>
+    using queue = sjtu::priority_queue<int, std::less<int>, std::allocator<int>, Policy>;
+
+    volatile long long sink;
+
+    template<class F>
+    double timed(F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<class Q>
+    long long drain(Q &q) {
+        long long sum = 0;
+        while (!q.empty()) {
+            sum += q.top();
+            q.pop();
+        }
+        return sum;
+    }
+
+    template<class Policy>
+    void run(const char *name, const std::vector<int> &keys) {
+        size_t n = keys.size();
+        double push_heavy = timed([&] {
+            queue<Policy> q;
+            for (int k : keys) q.push(k);
+            sink = drain(q);
+        });
+        double steady = timed([&] {
+            queue<Policy> q;
+            for (int k : keys) q.push(k);
+            long long sum = 0;
+            for (size_t i = 0; i < 4 * n; ++i) {
+                sum += q.top();
+                q.pop();
+                q.push(keys[i % n] ^ static_cast<int>(i));
+            }
+            sink = sum;
+        });
+        double merge_heavy = timed([&] {
+            std::vector<queue<Policy>> parts(n / 16);
+            for (size_t i = 0; i < n; ++i) parts[i % parts.size()].push(keys[i]);
+            queue<Policy> all;
+            for (auto &p : parts) all.merge(p);
+            sink = drain(all);
+        });
+        double range = timed([&] {
+            queue<Policy> q(keys.begin(), keys.end());
+            sink = drain(q);
+        });
+        std::printf("%-10s %12.1f %12.1f %12.1f %12.1f\n", name, push_heavy, steady, merge_heavy, range);
+    }
+
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::mt19937 rng(20240319);
+    std::vector<int> keys(n);
+    for (int &k : keys) k = static_cast<int>(rng());
+    std::printf("n = %zu, time in ms\n", n);
+    std::printf("%-10s %12s %12s %12s %12s\n", "engine", "push-heavy", "steady", "merge-heavy", "range");
+    run<sjtu::leftist_heap_policy>("leftist", keys);
+    run<sjtu::pairing_heap_policy>("pairing", keys);
+    run<sjtu::skew_heap_policy>("skew", keys);
+    run<sjtu::d_ary_heap_policy<4>>("4-ary", keys);
+    return 0;
+}
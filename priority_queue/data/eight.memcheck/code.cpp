@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string>
+
+#include "priority_queue.hpp"
+
+template<class Q>
+void TestMove(const char *name)
+{
+	std::cout << "Testing move and emplace of " << name << "..." << std::endl;
+	Q q;
+	std::string s = "moved";
+	q.push(std::move(s));
+	q.emplace(3, 'z');
+	q.emplace("apple");
+	q.push(std::string("kiwi"));
+	std::cout << q.size() << " " << q.top() << std::endl;
+	Q m(std::move(q));
+	std::cout << q.empty() << " " << m.size() << std::endl;
+	std::string top = m.pop_value();
+	std::cout << top << " " << m.size() << std::endl;
+	Q n;
+	n.push("pear");
+	n = std::move(m);
+	std::cout << n.size() << std::endl;
+	while (!n.empty()) {
+		std::cout << n.pop_value() << " ";
+	}
+	std::cout << std::endl;
+	try {
+		n.pop_value();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestMove<sjtu::priority_queue<std::string>>("leftist heap");
+	TestMove<sjtu::priority_queue<std::string, std::less<std::string>, std::allocator<std::string>, sjtu::d_ary_heap_policy<4>>>("d-ary heap");
+	TestMove<sjtu::priority_queue<std::string, std::less<std::string>, std::allocator<std::string>, sjtu::pairing_heap_policy>>("pairing heap");
+	TestMove<sjtu::priority_queue<std::string, std::less<std::string>, std::allocator<std::string>, sjtu::skew_heap_policy>>("skew heap");
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "concurrent_priority_queue.hpp"
+
+void TestStrictOrder()
+{
+	std::cout << "Testing strict concurrent_priority_queue..." << std::endl;
+	sjtu::concurrent_priority_queue<int> q(4, sjtu::queue_order::strict);
+	std::cout << q.shard_count() << " " << q.empty() << std::endl;
+	for (int i = 0; i < 20; ++i) {
+		q.push(i * 7 % 20);
+	}
+	std::cout << q.size() << std::endl;
+	int x;
+	while (q.try_pop(x)) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+	std::cout << q.try_pop(x) << " " << q.size() << std::endl;
+}
+
+void TestRelaxedSingleThread()
+{
+	std::cout << "Testing relaxed concurrent_priority_queue..." << std::endl;
+	sjtu::concurrent_priority_queue<int> q(8);
+	static bool seen[1000];
+	for (int i = 0; i < 1000; ++i) {
+		q.push(i);
+	}
+	int x, count = 0;
+	bool ok = true;
+	while (q.try_pop(x)) {
+		ok = ok && x >= 0 && x < 1000 && !seen[x];
+		seen[x] = true;
+		++count;
+	}
+	std::cout << (ok ? "ok." : "wrong.") << " " << count << " " << q.empty() << std::endl;
+}
+
+void TestManyThreads(sjtu::queue_order order)
+{
+	std::cout << "Testing concurrent push and pop..." << std::endl;
+	const int threads = 4, per_thread = 5000;
+	sjtu::concurrent_priority_queue<long long> q(2 * threads, order);
+	std::atomic<long long> popped_sum(0);
+	std::atomic<int> popped(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&q, &popped_sum, &popped, t] {
+			long long sum = 0;
+			int n = 0;
+			for (int i = 0; i < per_thread; ++i) {
+				q.push(t * per_thread + i);
+				long long x;
+				if (i % 2 == 1 && q.try_pop(x)) {
+					sum += x;
+					++n;
+				}
+			}
+			popped_sum += sum;
+			popped += n;
+		});
+	}
+	for (size_t t = 0; t < workers.size(); ++t) {
+		workers[t].join();
+	}
+	long long x, sum = popped_sum;
+	int n = popped;
+	while (q.try_pop(x)) {
+		sum += x;
+		++n;
+	}
+	long long total = (long long) threads * per_thread;
+	std::cout << n << " " << (sum == total * (total - 1) / 2) << " " << q.size() << std::endl;
+}
+
+int main()
+{
+	TestStrictOrder();
+	TestRelaxedSingleThread();
+	TestManyThreads(sjtu::queue_order::relaxed);
+	TestManyThreads(sjtu::queue_order::strict);
+	return 0;
+}
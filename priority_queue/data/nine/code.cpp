@@ -0,0 +1,68 @@
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+template<class Q>
+void drain(Q &q)
+{
+	while (!q.empty()) {
+		std::cout << q.top() << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+template<class Q>
+void TestEngine(const char *name)
+{
+	std::cout << "Testing " << name << "..." << std::endl;
+	Q q;
+	int a[] = {5, 1, 9, 3, 7, 2, 8};
+	q.push_range(a, a + 7);
+	std::cout << q.size() << " " << q.top() << std::endl;
+	std::vector<int> out;
+	q.top_k(3, std::back_inserter(out));
+	print(out);
+	out.clear();
+	q.top_k(100, std::back_inserter(out));
+	print(out);
+	std::cout << q.size() << std::endl;
+	out.clear();
+	q.pop_n(2, std::back_inserter(out));
+	print(out);
+	std::cout << q.pop_value() << " " << q.size() << std::endl;
+	Q other;
+	other.push(6);
+	other.push(10);
+	q.merge(other);
+	std::cout << other.empty() << " " << q.size() << std::endl;
+	out.clear();
+	q.top_k(0, std::back_inserter(out));
+	std::cout << out.size() << std::endl;
+	drain(q);
+	try {
+		q.pop_value();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestEngine<sjtu::priority_queue<int>>("leftist heap");
+	TestEngine<sjtu::priority_queue<int, std::less<int>, std::allocator<int>, sjtu::d_ary_heap_policy<4>>>("d-ary heap");
+	TestEngine<sjtu::priority_queue<int, std::less<int>, std::allocator<int>, sjtu::pairing_heap_policy>>("pairing heap");
+	TestEngine<sjtu::priority_queue<int, std::less<int>, std::allocator<int>, sjtu::skew_heap_policy>>("skew heap");
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "priority_queue.hpp"
+
+template<class Q>
+void drain(Q &q)
+{
+	while (!q.empty()) {
+		std::cout << q.top() << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+template<class Q>
+void TestHandles(const char *name)
+{
+	std::cout << "Testing handles of " << name << "..." << std::endl;
+	Q q;
+	typename Q::handle h[10];
+	for (int i = 0; i < 10; ++i) {
+		h[i] = q.push(i * 10);
+	}
+	q.increase_key(h[3], 100);
+	std::cout << q.top() << " " << *h[3] << std::endl;
+	q.decrease_key(h[3], 5);
+	std::cout << q.top() << " " << *h[3] << std::endl;
+	q.decrease_key(h[9], -1);
+	std::cout << q.top() << std::endl;
+	q.erase(h[8]);
+	std::cout << q.top() << " " << q.size() << std::endl;
+	q.increase_key(h[0], 75);
+	std::cout << q.top() << std::endl;
+	Q other;
+	typename Q::handle g = other.push(1);
+	other.push(2);
+	q.merge(other);
+	q.increase_key(g, 1000);
+	std::cout << q.top() << " " << q.size() << std::endl;
+	q.erase(g);
+	drain(q);
+	typename Q::handle none;
+	try {
+		q.erase(none);
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestHandles<sjtu::priority_queue<int>>("leftist heap");
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static unsigned reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) >> 1;
+}
+
+template<class Q>
+void drain(Q &q)
+{
+	while (!q.empty()) {
+		std::cout << q.top() << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+void TestBoundedPush()
+{
+	std::cout << "Testing bounded_heap push..." << std::endl;
+	sjtu::bounded_heap<int> q(5);
+	std::cout << q.max_size() << " " << q.empty() << " " << q.full() << std::endl;
+	int a[] = {4, 8, 1, 9, 6};
+	for (int i = 0; i < 5; ++i) {
+		std::cout << q.push(a[i]) << " ";
+	}
+	std::cout << std::endl;
+	std::cout << q.full() << " " << q.top() << " " << q.bottom() << std::endl;
+	std::cout << q.push(1) << " " << q.push(0) << " " << q.push(5) << " " << q.push(10) << std::endl;
+	std::cout << q.size() << " " << q.top() << " " << q.bottom() << std::endl;
+	q.pop_bottom();
+	std::cout << q.bottom() << " " << q.size() << std::endl;
+	drain(q);
+	try {
+		q.bottom();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+}
+
+void TestStreamingTopN()
+{
+	std::cout << "Testing streaming top-N..." << std::endl;
+	sjtu::bounded_heap<int> q(10);
+	sjtu::priority_queue<int> all;
+	for (int i = 0; i < 20000; ++i) {
+		int x = rand() % 100000;
+		q.push(x);
+		all.push(x);
+	}
+	bool ok = q.size() == 10;
+	while (!q.empty()) {
+		ok = ok && q.top() == all.top();
+		q.pop();
+		all.pop();
+	}
+	std::cout << (ok ? "ok." : "wrong.") << std::endl;
+}
+
+void TestBoundedCopyAndMerge()
+{
+	std::cout << "Testing bounded_heap copy and merge..." << std::endl;
+	sjtu::bounded_heap<std::string, std::greater<std::string>> q(3);
+	q.push("pear");
+	q.push("apple");
+	q.push("kiwi");
+	q.push("fig");
+	sjtu::bounded_heap<std::string, std::greater<std::string>> c(q);
+	sjtu::bounded_heap<std::string, std::greater<std::string>> other(4);
+	other.push("banana");
+	other.push("plum");
+	q.merge(other);
+	std::cout << other.empty() << " " << q.size() << std::endl;
+	drain(q);
+	drain(c);
+	sjtu::bounded_heap<std::string, std::greater<std::string>> z(0);
+	std::cout << z.push("any") << " " << z.size() << std::endl;
+	sjtu::priority_queue<int, std::less<int>, std::allocator<int>, sjtu::bounded_heap_policy> p(2);
+	p.push(3);
+	p.push(1);
+	p.push(2);
+	drain(p);
+}
+
+int main()
+{
+	TestBoundedPush();
+	TestStreamingTopN();
+	TestBoundedCopyAndMerge();
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+
+#include "priority_queue.hpp"
+
+// 构造次数用完时抛出异常。成员v在抛出之前已经写好，会覆盖掉节点所在空闲slot的next
+struct Fragile {
+	static int left;
+	int v;
+
+	Fragile(int v) : v(v) {
+		tick();
+	}
+
+	Fragile(const Fragile &other) : v(other.v) {
+		tick();
+	}
+
+	Fragile &operator=(const Fragile &other) = default;
+
+	static void tick() {
+		if (left >= 0 && left-- == 0) throw sjtu::runtime_error();
+	}
+
+	bool operator<(const Fragile &other) const {
+		return v < other.v;
+	}
+};
+int Fragile::left = -1;
+
+typedef sjtu::priority_queue<Fragile> leftist;
+typedef sjtu::priority_queue<Fragile, std::less<Fragile>, std::allocator<Fragile>, sjtu::pairing_heap_policy> pairing;
+typedef sjtu::priority_queue<Fragile, std::less<Fragile>, std::allocator<Fragile>, sjtu::skew_heap_policy> skew;
+
+template<class Q>
+void drain(Q &q)
+{
+	while (!q.empty()) {
+		std::cout << q.top().v << " ";
+		q.pop();
+	}
+	std::cout << std::endl;
+}
+
+template<class Q>
+void TestReuse(const char *name)
+{
+	std::cout << "Testing node reuse of " << name << "..." << std::endl;
+	Q q;
+	std::cout << q.capacity() << std::endl;
+	q.reserve(100);
+	std::cout << q.capacity() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		q.push(i * 37 % 100);
+	}
+	for (int i = 0; i < 60; ++i) {
+		q.pop();
+	}
+	std::cout << q.size() << " " << q.capacity() << std::endl;
+	for (int i = 0; i < 60; ++i) {
+		q.push(i);
+	}
+	std::cout << q.size() << " " << q.capacity() << " " << q.top().v << std::endl;
+	q.reserve(50);
+	std::cout << q.capacity() << std::endl;
+	while (q.size() > 3) {
+		q.pop();
+	}
+	q.shrink_to_fit();
+	std::cout << (q.capacity() < 100) << " " << (q.capacity() >= 3) << std::endl;
+	drain(q);
+	q.shrink_to_fit();
+	std::cout << q.capacity() << std::endl;
+}
+
+template<class Q>
+void TestThrowingConstructor(const char *name)
+{
+	std::cout << "Testing a throwing element constructor in " << name << "..." << std::endl;
+	Q q;
+	for (int i = 0; i < 16; ++i) {
+		q.push(i);
+	}
+	for (int i = 0; i < 4; ++i) {
+		q.pop();
+	}
+	size_t cap = q.capacity();
+	for (int round = 0; round < 3; ++round) {
+		Fragile::left = 0;
+		try {
+			q.emplace(100 + round);
+		} catch (sjtu::runtime_error &) {
+			std::cout << "Throw correctly. ";
+		}
+		Fragile::left = -1;
+	}
+	std::cout << q.size() << " " << q.top().v << std::endl;
+	for (int i = 0; i < 4; ++i) {
+		q.push(20 + i);
+	}
+	std::cout << q.size() << " " << (q.capacity() == cap) << std::endl;
+	drain(q);
+	q.shrink_to_fit();
+	std::cout << q.capacity() << std::endl;
+}
+
+int main()
+{
+	TestReuse<leftist>("leftist heap");
+	TestReuse<pairing>("pairing heap");
+	TestReuse<skew>("skew heap");
+	TestThrowingConstructor<leftist>("leftist heap");
+	TestThrowingConstructor<pairing>("pairing heap");
+	TestThrowingConstructor<skew>("skew heap");
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+// 比较次数用完时抛出异常。每个操作在所有可能抛出的位置都试一次，
+// 抛出时堆必须和操作之前一样，没有抛出时必须和std::vector上做同样操作的结果一样。
+struct Budget {
+	static int left;
+};
+int Budget::left = -1;
+
+struct ThrowingLess {
+	bool operator()(int a, int b) const {
+		if (Budget::left >= 0 && Budget::left-- == 0) throw sjtu::runtime_error();
+		return a < b;
+	}
+};
+
+typedef sjtu::priority_queue<int, ThrowingLess> leftist;
+typedef sjtu::priority_queue<int, ThrowingLess, std::allocator<int>, sjtu::d_ary_heap_policy<4>> d_ary;
+typedef sjtu::priority_queue<int, ThrowingLess, std::allocator<int>, sjtu::pairing_heap_policy> pairing;
+typedef sjtu::priority_queue<int, ThrowingLess, std::allocator<int>, sjtu::skew_heap_policy> skew;
+typedef sjtu::bounded_heap<int, ThrowingLess> bounded;
+
+template<class Q>
+std::vector<int> contents(const Q &q)
+{
+	int saved = Budget::left;
+	Budget::left = -1;
+	Q c(q);
+	std::vector<int> v;
+	while (!c.empty()) {
+		v.push_back(c.top());
+		c.pop();
+	}
+	Budget::left = saved;
+	return v;
+}
+
+// 从empty复制出一个堆，用fill填好，再在预算0..199下分别执行op。model对排好序的内容做同样的修改。
+template<class Q, class Fill, class Op, class Model>
+bool check(const Q &empty, Fill fill, Op op, Model model, int &thrown)
+{
+	for (int budget = 0; budget < 200; ++budget) {
+		Q q(empty);
+		fill(q);
+		std::vector<int> before = contents(q), after = before;
+		model(after);
+		std::sort(after.begin(), after.end(), std::greater<int>());
+		bool ok;
+		Budget::left = budget;
+		try {
+			op(q);
+			Budget::left = -1;
+			ok = contents(q) == after;
+		} catch (sjtu::runtime_error &) {
+			Budget::left = -1;
+			++thrown;
+			ok = contents(q) == before;
+		}
+		if (!ok) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<class Q>
+void fill16(Q &q)
+{
+	for (int i = 0; i < 16; ++i) {
+		q.push(i * 37 % 101);
+	}
+}
+
+template<class Q>
+bool check_common(const Q &empty, int &thrown)
+{
+	static const int range[] = {50, 3, 77, 12, 90};
+	bool ok = check(empty, fill16<Q>, [](Q &q) { q.push(45); },
+	                [](std::vector<int> &v) { v.push_back(45); }, thrown);
+	ok = ok && check(empty, fill16<Q>, [](Q &q) { q.pop(); },
+	                 [](std::vector<int> &v) { v.erase(v.begin()); }, thrown);
+	ok = ok && check(empty, fill16<Q>, [](Q &q) { q.pop_value(); },
+	                 [](std::vector<int> &v) { v.erase(v.begin()); }, thrown);
+	ok = ok && check(empty, fill16<Q>, [](Q &q) { q.push_range(range, range + 5); },
+	                 [](std::vector<int> &v) { v.insert(v.end(), range, range + 5); }, thrown);
+	ok = ok && check(empty, fill16<Q>, [](Q &q) {
+		std::vector<int> out;
+		q.top_k(5, std::back_inserter(out));
+	}, [](std::vector<int> &) {}, thrown);
+	return ok;
+}
+
+template<class Q>
+bool check_handles(int &thrown)
+{
+	static typename Q::handle h;
+	auto fill = [](Q &q) {
+		fill16(q);
+		h = q.push(40);
+	};
+	bool ok = check(Q(), fill, [](Q &q) { q.increase_key(h, 95); },
+	                [](std::vector<int> &v) { *std::find(v.begin(), v.end(), 40) = 95; }, thrown);
+	ok = ok && check(Q(), fill, [](Q &q) { q.decrease_key(h, 1); },
+	                 [](std::vector<int> &v) { *std::find(v.begin(), v.end(), 40) = 1; }, thrown);
+	ok = ok && check(Q(), fill, [](Q &q) { q.erase(h); },
+	                 [](std::vector<int> &v) { v.erase(std::find(v.begin(), v.end(), 40)); }, thrown);
+	return ok;
+}
+
+template<class Q>
+void TestEngine(const char *name)
+{
+	int thrown = 0;
+	bool ok = check_common(Q(), thrown);
+	std::cout << "Testing " << name << " with a throwing comparator..." << (ok && thrown > 0 ? "ok." : "wrong.") << std::endl;
+}
+
+template<class Q>
+void TestHandles(const char *name)
+{
+	int thrown = 0;
+	bool ok = check_handles<Q>(thrown);
+	std::cout << "Testing handles of " << name << " with a throwing comparator..." << (ok && thrown > 0 ? "ok." : "wrong.") << std::endl;
+}
+
+void TestBounded()
+{
+	int thrown = 0;
+	bool ok = check(bounded(16), fill16<bounded>, [](bounded &q) { q.push(60); }, [](std::vector<int> &v) {
+		v.push_back(60);
+		std::sort(v.begin(), v.end(), std::greater<int>());
+		v.pop_back();
+	}, thrown);
+	ok = ok && check(bounded(16), fill16<bounded>, [](bounded &q) { q.pop_bottom(); },
+	                 [](std::vector<int> &v) { v.erase(std::min_element(v.begin(), v.end())); }, thrown);
+	ok = ok && check(bounded(16), fill16<bounded>, [](bounded &q) { q.pop(); },
+	                 [](std::vector<int> &v) { v.erase(std::max_element(v.begin(), v.end())); }, thrown);
+	std::cout << "Testing bounded_heap with a throwing comparator..." << (ok && thrown > 0 ? "ok." : "wrong.") << std::endl;
+}
+
+int main()
+{
+	TestEngine<leftist>("leftist heap");
+	TestEngine<d_ary>("d-ary heap");
+	TestEngine<pairing>("pairing heap");
+	TestEngine<skew>("skew heap");
+	TestHandles<leftist>("leftist heap");
+	TestHandles<pairing>("pairing heap");
+	TestBounded();
+	return 0;
+}
@@ -0,0 +1,340 @@
+#ifndef SJTU_BOUNDED_HEAP_HPP
+#define SJTU_BOUNDED_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a heap keeping only the best max_size() elements it has been given, for streaming top-N.
+ * the elements live in a min-max heap in one array allocated once:
+ *   the root is the best element, the worst kept one is among its two children.
+ * once the heap is full, push finds the worst kept one (one comparison between the root's children)
+ *   and compares the new element with it: if it is not better it is rejected after these two comparisons,
+ *   otherwise it replaces the worst one in O(logN).
+ * Compare works as in priority_queue: top() is the element that is not less than any other.
+ *
+ * if Compare throws, the operation is abandoned and the heap is left as it was:
+ *   every sift first finds the final positions with comparisons only, and moves elements afterwards.
+ */
+    template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+    class bounded_heap {
+    public:
+        typedef Allocator allocator_type;
+
+        explicit bounded_heap(size_t max_size, const Compare &comp = Compare(), const Allocator &_alloc = Allocator())
+                : heap(nullptr), ele_num(0), limit(max_size), cmp(comp), alloc(_alloc) {
+            if (limit > 0) heap = alloc_traits::allocate(alloc, limit);
+        }
+
+        bounded_heap(const bounded_heap &other)
+                : bounded_heap(other, alloc_traits::select_on_container_copy_construction(other.alloc)) {}
+
+        /**
+         * copy other, taking memory from _alloc.
+         */
+        bounded_heap(const bounded_heap &other, const Allocator &_alloc)
+                : heap(nullptr), ele_num(0), limit(other.limit), cmp(other.cmp), alloc(_alloc) {
+            if (limit > 0) heap = alloc_traits::allocate(alloc, limit);
+            try {
+                for (; ele_num < other.ele_num; ++ele_num) {
+                    alloc_traits::construct(alloc, heap + ele_num, other.heap[ele_num]);
+                }
+            } catch (...) {
+                clear();
+                alloc_traits::deallocate(alloc, heap, limit);
+                throw;
+            }
+        }
+
+        bounded_heap(bounded_heap &&other) noexcept(std::is_nothrow_move_constructible<Compare>::value)
+                : heap(other.heap), ele_num(other.ele_num), limit(other.limit), cmp(std::move(other.cmp)),
+                  alloc(std::move(other.alloc)) {
+            other.heap = nullptr;
+            other.ele_num = other.limit = 0;
+        }
+
+        ~bounded_heap() {
+            clear();
+            if (heap != nullptr) alloc_traits::deallocate(alloc, heap, limit);
+        }
+
+        /**
+         * the allocator is taken from other only if it propagates on copy assignment.
+         */
+        bounded_heap &operator=(const bounded_heap &other) {
+            if (this == &other) return *this;
+            //先用最终要用的分配器复制出来，失败时*this保持原样
+            bounded_heap temp(other, alloc_traits::propagate_on_container_copy_assignment::value ? other.alloc : alloc);
+            swap_content(temp);
+            return *this;
+        }
+
+        /**
+         * free the own array and take over that of other, other is left with no room at all.
+         * both heaps should use equal allocators, unless the allocator propagates on move assignment.
+         */
+        bounded_heap &operator=(bounded_heap &&other) {
+            if (this == &other) return *this;
+            clear();
+            if (heap != nullptr) alloc_traits::deallocate(alloc, heap, limit);
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) alloc = std::move(other.alloc);
+            heap = other.heap;
+            ele_num = other.ele_num;
+            limit = other.limit;
+            cmp = std::move(other.cmp);
+            other.heap = nullptr;
+            other.ele_num = other.limit = 0;
+            return *this;
+        }
+
+        /**
+         * get the best element kept.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            if (ele_num == 0) throw container_is_empty();
+            return heap[0];
+        }
+
+        /**
+         * get the worst element kept, the one the next better push will drop.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &bottom() const {
+            if (ele_num == 0) throw container_is_empty();
+            return heap[worst()];
+        }
+
+        /**
+         * offer a new element.
+         * @return true if it is kept, false if the heap is full and e is not better than bottom().
+         */
+        bool push(const T &e) {
+            return offer(e);
+        }
+
+        bool push(T &&e) {
+            return offer(std::move(e));
+        }
+
+        /**
+         * delete the best element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (ele_num == 0) throw container_is_empty();
+            remove_at(0);
+        }
+
+        /**
+         * delete the worst element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop_bottom() {
+            if (ele_num == 0) throw container_is_empty();
+            remove_at(worst());
+        }
+
+        /**
+         * return the number of the elements.
+         */
+        size_t size() const {
+            return ele_num;
+        }
+
+        /**
+         * check if the container has at least an element.
+         * @return true if it is empty, false if it has at least an element.
+         */
+        bool empty() const {
+            return ele_num == 0;
+        }
+
+        /**
+         * the number of elements kept at most, fixed at construction.
+         */
+        size_t max_size() const {
+            return limit;
+        }
+
+        bool full() const {
+            return ele_num == limit;
+        }
+
+        /**
+         * offer all the elements of other, O(mlogN), and clear other.
+         */
+        void merge(bounded_heap &other) {
+            if (this == &other) return;
+            while (other.ele_num > 0) {
+                push(other.heap[other.ele_num - 1]);
+                --other.ele_num;
+                alloc_traits::destroy(other.alloc, other.heap + other.ele_num);
+            }
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return alloc;
+        }
+
+    private:
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        T *heap;
+        size_t ele_num;
+        size_t limit;
+        Compare cmp;
+        Allocator alloc;
+
+        void clear() {
+            for (size_t i = 0; i < ele_num; ++i) alloc_traits::destroy(alloc, heap + i);
+            ele_num = 0;
+        }
+
+        void swap_content(bounded_heap &other) {
+            std::swap(heap, other.heap);
+            std::swap(ele_num, other.ele_num);
+            std::swap(limit, other.limit);
+            std::swap(cmp, other.cmp);
+            std::swap(alloc, other.alloc);  //数组总是和分配它的分配器在一起
+        }
+
+        //深度为偶数的层是max层，放更好的元素；奇数层是min层，放更差的元素
+        static bool is_max_level(size_t i) {
+            size_t depth = 0;
+            for (size_t x = i + 1; x > 1; x >>= 1) ++depth;
+            return depth % 2 == 0;
+        }
+
+        //a在这一层应该排在b上面：在max层是a比b好，在min层是a比b差
+        bool above(const T &a, const T &b, bool max_level) const {
+            return max_level ? cmp(b, a) : cmp(a, b);
+        }
+
+        //最差的元素是根的两个孩子中较差的一个，需要一次比较
+        size_t worst() const {
+            if (ele_num <= 2) return ele_num - 1;
+            return cmp(heap[2], heap[1]) ? 2 : 1;
+        }
+
+        template<class U>
+        bool offer(U &&e) {
+            if (ele_num < limit) {
+                alloc_traits::construct(alloc, heap + ele_num, std::forward<U>(e));
+                ++ele_num;
+                try {
+                    bubble_up(ele_num - 1);
+                } catch (...) {
+                    --ele_num;
+                    alloc_traits::destroy(alloc, heap + ele_num);
+                    throw;
+                }
+                return true;
+            }
+            if (limit == 0) return false;
+            size_t w = worst();
+            if (!cmp(heap[w], e)) return false;
+            T x(std::forward<U>(e));
+            if (w == 0) {  //只能放一个元素
+                heap[0] = std::move(x);
+                return true;
+            }
+            //w在第一层（min层）。新元素比根还好时和根交换，换下来的根从w往下沉。
+            bool swap_root = cmp(heap[0], x);
+            trickle_down(w, x, false, ele_num, swap_root);
+            return true;
+        }
+
+        //删掉位置i上的元素，最后一个元素从i往下沉补上空位
+        void remove_at(size_t i) {
+            size_t last = ele_num - 1;
+            if (i != last) {
+                T x(std::move(heap[last]));
+                try {
+                    trickle_down(i, x, is_max_level(i), last, false);
+                } catch (...) {
+                    heap[last] = std::move(x);
+                    throw;
+                }
+            }
+            alloc_traits::destroy(alloc, heap + last);
+            --ele_num;
+        }
+
+        //位置i是空位，x从i往下沉，只看前n个元素。swap_root为真时x先和根交换（i是根的儿子）。
+        //先只做比较，记下每一步落到哪个位置、是否要和途中的父亲交换，然后再移动元素。
+        void trickle_down(size_t i, T &x, bool max_level, size_t n, bool swap_root) {
+            size_t to[64];        //每一步x的空位移到的位置
+            bool swap_up[64];     //这一步之后是否要和空位的父亲交换
+            size_t steps = 0;
+            const T *mv = swap_root ? &heap[0] : &x;  //正在往下沉的值
+            for (size_t cur = i;;) {
+                size_t c = 2 * cur + 1;
+                if (c >= n) break;
+                size_t m = c;  //儿子和孙子中最应该排在上面的一个
+                if (c + 1 < n && above(heap[c + 1], heap[m], max_level)) m = c + 1;
+                for (size_t g = 2 * c + 1; g < 2 * c + 5 && g < n; ++g) {
+                    if (above(heap[g], heap[m], max_level)) m = g;
+                }
+                if (!above(heap[m], *mv, max_level)) break;
+                to[steps] = m;
+                swap_up[steps] = false;
+                ++steps;
+                if (m < 2 * c + 1) break;  //m是儿子，下面已经没有同类的层了
+                size_t p = (m - 1) / 2;
+                if (above(*mv, heap[p], !max_level)) {
+                    swap_up[steps - 1] = true;
+                    mv = &heap[p];
+                }
+                cur = m;
+            }
+            if (swap_root) std::swap(x, heap[0]);
+            for (size_t s = 0; s < steps; ++s) {
+                heap[i] = std::move(heap[to[s]]);
+                i = to[s];
+                if (swap_up[s]) std::swap(x, heap[(i - 1) / 2]);
+            }
+            heap[i] = std::move(x);
+        }
+
+        //heap[pos]是新放进来的元素，把它上移到正确位置。同样先比较找到目标位置，再移动元素。
+        void bubble_up(size_t pos) {
+            if (pos == 0) return;
+            const T &v = heap[pos];
+            bool max_level = is_max_level(pos);
+            size_t parent = (pos - 1) / 2;
+            bool jump = above(v, heap[parent], !max_level);  //应该属于另一类层，先和父亲交换
+            size_t target = jump ? parent : pos;
+            if (jump) max_level = !max_level;
+            while (target >= 3) {
+                size_t g = ((target - 1) / 2 - 1) / 2;
+                if (!above(v, heap[g], max_level)) break;
+                target = g;
+            }
+            if (!jump && target == pos) return;
+            T x(std::move(heap[pos]));
+            size_t hole = pos;
+            if (jump) {
+                heap[hole] = std::move(heap[parent]);
+                hole = parent;
+            }
+            while (hole != target) {
+                size_t g = ((hole - 1) / 2 - 1) / 2;
+                heap[hole] = std::move(heap[g]);
+                hole = g;
+            }
+            heap[hole] = std::move(x);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+#define SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "d_ary_heap.hpp"
+
+namespace sjtu {
+
+/**
+ * how closely concurrent_priority_queue::try_pop follows the priority order.
+ * relaxed: look at two random shards and pop the better of their tops (the MultiQueue rule),
+ *   an element close to, but not always exactly, the best one is returned.
+ * strict: lock every shard and pop the best top of all, exactly like one priority_queue.
+ */
+    enum class queue_order {
+        relaxed, strict
+    };
+
+/**
+ * a priority queue many threads can use at once, made of several shards:
+ *   each shard is a d-ary heap behind its own mutex.
+ * try_push puts the element into a random shard, so pushes from different threads rarely meet.
+ * the more shards, the less contention and (in relaxed mode) the looser the order;
+ *   a few shards per thread is the usual choice.
+ * Compare works as in priority_queue.
+ * the shards allocate concurrently, each under its own lock only, so Allocator must be
+ *   stateless (is_always_equal), like std::allocator: the copies of a stateful allocator
+ *   such as arena_allocator or pool_allocator would share one unsynchronized arena or pool.
+ */
+    template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+    class concurrent_priority_queue {
+        static_assert(std::allocator_traits<Allocator>::is_always_equal::value,
+                      "concurrent_priority_queue needs a stateless allocator");
+
+    public:
+        typedef Allocator allocator_type;
+
+        /**
+         * @param shards number of shards, 0 means two per hardware thread.
+         */
+        explicit concurrent_priority_queue(size_t shards = 0, queue_order _order = queue_order::relaxed,
+                                           const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+                : shard_alloc(alloc), shard_num(shards > 0 ? shards : default_shards()), order(_order), cmp(comp) {
+            parts = shard_traits::allocate(shard_alloc, shard_num);
+            size_t i = 0;
+            try {
+                for (; i < shard_num; ++i) shard_traits::construct(shard_alloc, parts + i, comp, alloc);
+            } catch (...) {
+                while (i > 0) shard_traits::destroy(shard_alloc, parts + --i);
+                shard_traits::deallocate(shard_alloc, parts, shard_num);
+                throw;
+            }
+        }
+
+        concurrent_priority_queue(const concurrent_priority_queue &) = delete;
+
+        concurrent_priority_queue &operator=(const concurrent_priority_queue &) = delete;
+
+        ~concurrent_priority_queue() {
+            for (size_t i = 0; i < shard_num; ++i) shard_traits::destroy(shard_alloc, parts + i);
+            shard_traits::deallocate(shard_alloc, parts, shard_num);
+        }
+
+        /**
+         * push e into a shard that is not locked at the moment.
+         * @return false if every shard tried was busy; e is not pushed then.
+         */
+        bool try_push(const T &e) {
+            return try_emplace_impl(e);
+        }
+
+        bool try_push(T &&e) {
+            return try_emplace_impl(std::move(e));
+        }
+
+        /**
+         * push e, waiting for a shard if all the ones tried are busy.
+         */
+        void push(const T &e) {
+            emplace_impl(e);
+        }
+
+        void push(T &&e) {
+            emplace_impl(std::move(e));
+        }
+
+        /**
+         * pop an element into out, following the order chosen at construction.
+         * @return false if the queue was found empty.
+         */
+        bool try_pop(T &out) {
+            return (order == queue_order::strict) ? pop_strict(out) : pop_relaxed(out);
+        }
+
+        /**
+         * the number of elements; only a snapshot while other threads are working.
+         */
+        size_t size() const {
+            return ele_num.load(std::memory_order_relaxed);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_t shard_count() const {
+            return shard_num;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(shard_alloc);
+        }
+
+    private:
+        struct alignas(64) shard {  //每个shard独占缓存行，避免不同线程之间的伪共享
+            std::mutex lock;
+            d_ary_heap<T, Compare, Allocator, 4> heap;
+
+            shard(const Compare &comp, const Allocator &alloc) : heap(comp, alloc) {}
+        };
+
+        using shard_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<shard>;
+        using shard_traits = std::allocator_traits<shard_allocator>;
+
+        static constexpr size_t push_attempts = 4;  //try_push最多试几个shard
+        static constexpr size_t pop_attempts = 8;   //pop_relaxed用try_lock抽样的次数，之后改为等待
+
+        shard_allocator shard_alloc;
+        shard *parts;
+        size_t shard_num;
+        queue_order order;
+        Compare cmp;
+        std::atomic<size_t> ele_num{0};
+
+        static size_t default_shards() {
+            size_t threads = std::thread::hardware_concurrency();
+            return 2 * (threads > 0 ? threads : 1);
+        }
+
+        //每个线程一个xorshift随机数发生器，用线程局部变量的地址做种子
+        static size_t random_index(size_t n) {
+            thread_local uint64_t state = 0;
+            if (state == 0) state = reinterpret_cast<uintptr_t>(&state) | 1;
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<size_t>(state % n);
+        }
+
+        template<class U>
+        bool try_emplace_impl(U &&e) {
+            for (size_t k = 0; k < push_attempts; ++k) {
+                shard &s = parts[random_index(shard_num)];
+                if (!s.lock.try_lock()) continue;
+                std::lock_guard<std::mutex> guard(s.lock, std::adopt_lock);
+                s.heap.push(std::forward<U>(e));
+                ele_num.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        template<class U>
+        void emplace_impl(U &&e) {
+            if (try_emplace_impl(std::forward<U>(e))) return;  //失败时e没有被用掉
+            shard &s = parts[random_index(shard_num)];
+            std::lock_guard<std::mutex> guard(s.lock);
+            s.heap.push(std::forward<U>(e));
+            ele_num.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //从锁住的shard中取出堆顶
+        bool take(shard &s, T &out) {
+            out = s.heap.pop_value();
+            ele_num.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        //随机抽两个shard，从堆顶更好的那个里取。抽到的都空时挨个检查所有shard。
+        bool pop_relaxed(T &out) {
+            if (shard_num == 1) return pop_strict(out);
+            for (size_t k = 0; k < pop_attempts; ++k) {
+                size_t i = random_index(shard_num), j = random_index(shard_num - 1);
+                if (j >= i) ++j;
+                shard &a = parts[i], &b = parts[j];
+                if (!a.lock.try_lock()) continue;
+                std::lock_guard<std::mutex> guard_a(a.lock, std::adopt_lock);
+                if (!b.lock.try_lock()) continue;
+                std::lock_guard<std::mutex> guard_b(b.lock, std::adopt_lock);
+                if (a.heap.empty() && b.heap.empty()) break;
+                if (b.heap.empty()) return take(a, out);
+                if (a.heap.empty()) return take(b, out);
+                return take(cmp(a.heap.top(), b.heap.top()) ? b : a, out);
+            }
+            if (ele_num.load(std::memory_order_relaxed) == 0) return false;
+            size_t start = random_index(shard_num);
+            for (size_t k = 0; k < shard_num; ++k) {
+                shard &s = parts[(start + k) % shard_num];
+                std::lock_guard<std::mutex> guard(s.lock);
+                if (!s.heap.empty()) return take(s, out);
+            }
+            return false;
+        }
+
+        //按编号顺序锁住所有shard，取出所有堆顶中最好的一个
+        bool pop_strict(T &out) {
+            for (size_t i = 0; i < shard_num; ++i) parts[i].lock.lock();
+            shard *best = nullptr;
+            try {
+                for (size_t i = 0; i < shard_num; ++i) {
+                    if (parts[i].heap.empty()) continue;
+                    if (best == nullptr || cmp(best->heap.top(), parts[i].heap.top())) best = parts + i;
+                }
+                if (best != nullptr) take(*best, out);
+            } catch (...) {
+                for (size_t i = 0; i < shard_num; ++i) parts[i].lock.unlock();
+                throw;
+            }
+            for (size_t i = 0; i < shard_num; ++i) parts[i].lock.unlock();
+            return best != nullptr;
+        }
+    };
+
+}
+
+#endif
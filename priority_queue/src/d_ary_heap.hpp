@@ -0,0 +1,427 @@
+#ifndef SJTU_D_ARY_HEAP_HPP
+#define SJTU_D_ARY_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "heap_ops.hpp"
+
+namespace sjtu {
+
+/**
+ * an implicit d-ary heap stored in one contiguous array.
+ * the children of a[i] are a[D*i+1] ... a[D*i+D], so there is no node and no pointer at all.
+ * Compare works as in priority_queue: top() is the element that is not less than any other.
+ * pop_value, pop_n and top_k come from heap_ops, so does the rule for a throwing Compare:
+ *   every sift first finds the final position with comparisons only, and moves elements afterwards.
+ */
+    template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>, size_t D = 4>
+    class d_ary_heap : public heap_ops<d_ary_heap<T, Compare, Allocator, D>, T, Compare> {
+        static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+
+        friend class heap_ops<d_ary_heap, T, Compare>;
+
+    public:
+        typedef Allocator allocator_type;
+
+        d_ary_heap() : d_ary_heap(Compare()) {}
+
+        explicit d_ary_heap(const Compare &comp, const Allocator &_alloc = Allocator())
+                : heap(nullptr), ele_num(0), capacity(0), cmp(comp), alloc(_alloc) {}
+
+        explicit d_ary_heap(const Allocator &_alloc) : d_ary_heap(Compare(), _alloc) {}
+
+        /**
+         * build the heap from [first, last) in O(n) with Floyd's bottom-up heapify.
+         */
+        template<class InputIterator>
+        d_ary_heap(InputIterator first, InputIterator last, const Compare &comp = Compare(),
+                   const Allocator &_alloc = Allocator())
+                : d_ary_heap(comp, _alloc) {
+            push_range(first, last);
+        }
+
+        d_ary_heap(const d_ary_heap &other)
+                : heap(nullptr), ele_num(0), capacity(0), cmp(other.cmp),
+                  alloc(alloc_traits::select_on_container_copy_construction(other.alloc)) {
+            copy_from(other);
+        }
+
+        /**
+         * take over the array of other in O(1), other is left empty.
+         */
+        d_ary_heap(d_ary_heap &&other) noexcept(std::is_nothrow_move_constructible<Compare>::value)
+                : heap(other.heap), ele_num(other.ele_num), capacity(other.capacity), cmp(std::move(other.cmp)),
+                  alloc(std::move(other.alloc)) {
+            other.heap = nullptr;
+            other.ele_num = other.capacity = 0;
+        }
+
+        ~d_ary_heap() {
+            clear();
+            alloc_traits::deallocate(alloc, heap, capacity);
+        }
+
+        /**
+         * the allocator is taken from other only if it propagates on copy assignment.
+         */
+        d_ary_heap &operator=(const d_ary_heap &other) {
+            if (this == &other) return *this;
+            //先用最终要用的分配器复制出来，失败时*this保持原样
+            d_ary_heap temp(other.cmp, alloc_traits::propagate_on_container_copy_assignment::value ? other.alloc : alloc);
+            temp.copy_from(other);
+            swap_content(temp);
+            return *this;
+        }
+
+        /**
+         * free the own array and take over that of other in O(1), other is left empty.
+         * both heaps should use equal allocators, unless the allocator propagates on move assignment.
+         */
+        d_ary_heap &operator=(d_ary_heap &&other) {
+            if (this == &other) return *this;
+            clear();
+            alloc_traits::deallocate(alloc, heap, capacity);
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) alloc = std::move(other.alloc);
+            heap = other.heap;
+            ele_num = other.ele_num;
+            capacity = other.capacity;
+            cmp = std::move(other.cmp);
+            other.heap = nullptr;
+            other.ele_num = other.capacity = 0;
+            return *this;
+        }
+
+        /**
+         * get the top of the queue.
+         * @return a reference of the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            if (ele_num == 0) throw container_is_empty();
+            return heap[0];
+        }
+
+        /**
+         * push new element to the priority queue.
+         */
+        void push(const T &e) {
+            emplace(e);
+        }
+
+        void push(T &&e) {
+            emplace(std::move(e));
+        }
+
+        /**
+         * construct a new element in place from args and push it.
+         */
+        template<class... Args>
+        void emplace(Args &&... args) {
+            if (ele_num == capacity) {  //args可能引用堆中的元素，先构造出来再扩容
+                T temp(std::forward<Args>(args)...);
+                grow();
+                alloc_traits::construct(alloc, heap + ele_num, std::move(temp));
+            } else {
+                alloc_traits::construct(alloc, heap + ele_num, std::forward<Args>(args)...);
+            }
+            ++ele_num;
+            try {
+                sift_up(ele_num - 1);
+            } catch (...) {
+                --ele_num;
+                alloc_traits::destroy(alloc, heap + ele_num);
+                throw;
+            }
+        }
+
+        /**
+         * delete the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (ele_num == 0) throw container_is_empty();
+            finish_pop(plan_pop());  //plan_pop可能抛出异常，此时堆还没有被改动
+        }
+
+        /**
+         * push all the elements of [first, last).
+         * an empty heap is built by Floyd's heapify in O(m); otherwise every new element is sifted up.
+         * if Compare throws, the new elements are removed again and the heap is left as it was.
+         */
+        template<class InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            using category = typename std::iterator_traits<InputIterator>::iterator_category;
+            if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+                size_t n = static_cast<size_t>(std::distance(first, last));
+                if (ele_num + n > capacity) reallocate(ele_num + n);
+            }
+            size_t old = ele_num;
+            try {
+                for (; first != last; ++first) {
+                    if (ele_num == capacity) grow();
+                    alloc_traits::construct(alloc, heap + ele_num, *first);
+                    ++ele_num;
+                }
+            } catch (...) {
+                while (ele_num > old) alloc_traits::destroy(alloc, heap + --ele_num);
+                throw;
+            }
+            if (old == 0) {
+                try {
+                    heapify();
+                } catch (...) {  //原来就是空的
+                    clear();
+                    throw;
+                }
+                return;
+            }
+            //记下每个新元素上移到的位置，失败时倒着撤销，堆回到push_range之前的样子
+            using index_allocator = typename alloc_traits::template rebind_alloc<size_t>;
+            using index_traits = std::allocator_traits<index_allocator>;
+            index_allocator index_alloc(alloc);
+            size_t m = ele_num - old;
+            size_t *target;
+            try {
+                target = index_traits::allocate(index_alloc, m);
+            } catch (...) {
+                while (ele_num > old) alloc_traits::destroy(alloc, heap + --ele_num);
+                throw;
+            }
+            size_t i = old;
+            try {
+                for (; i < ele_num; ++i) target[i - old] = sift_up(i);
+            } catch (...) {  //sift_up失败时heap[i]还在原位
+                while (i > old) {
+                    --i;
+                    unsift(i, target[i - old]);
+                }
+                while (ele_num > old) alloc_traits::destroy(alloc, heap + --ele_num);
+                index_traits::deallocate(index_alloc, target, m);
+                throw;
+            }
+            index_traits::deallocate(index_alloc, target, m);
+        }
+
+        /**
+         * return the number of the elements.
+         */
+        size_t size() const {
+            return ele_num;
+        }
+
+        /**
+         * check if the container has at least an element.
+         * @return true if it is empty, false if it has at least an element.
+         */
+        bool empty() const {
+            return ele_num == 0;
+        }
+
+        /**
+         * merge other into this heap and clear other.
+         * an array heap cannot be merged in O(logn): the elements of other are
+         *   moved over one by one, O(m log(n+m)). use the leftist policy if merge is hot.
+         * if Compare throws, the element being moved goes back to other, both heaps stay valid.
+         */
+        void merge(d_ary_heap &other) {
+            if (this == &other) return;
+            while (!other.empty()) {
+                T &e = other.heap[other.ele_num - 1];
+                if (ele_num == capacity) grow();
+                alloc_traits::construct(alloc, heap + ele_num, std::move(e));
+                ++ele_num;
+                try {
+                    sift_up(ele_num - 1);
+                } catch (...) {  //sift_up比较完才移动元素，新元素仍在末尾
+                    --ele_num;
+                    e = std::move(heap[ele_num]);
+                    alloc_traits::destroy(alloc, heap + ele_num);
+                    throw;
+                }
+                --other.ele_num;
+                alloc_traits::destroy(other.alloc, other.heap + other.ele_num);
+            }
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return alloc;
+        }
+
+    private:
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        T *heap;
+        size_t ele_num;
+        size_t capacity;
+        Compare cmp;
+        Allocator alloc;
+
+        void clear() {
+            for (size_t i = 0; i < ele_num; ++i) alloc_traits::destroy(alloc, heap + i);
+            ele_num = 0;
+        }
+
+        //heap_ops用到的接口。pop_plan是最后一个元素要填进的空位。
+        typedef size_t pop_plan;
+        typedef size_t position;
+
+        pop_plan plan_pop() const {
+            return (ele_num > 1) ? find_hole(0, heap[ele_num - 1], ele_num - 1) : 0;
+        }
+
+        T &top_slot() {
+            return heap[0];
+        }
+
+        void finish_pop(pop_plan hole) {
+            if (ele_num > 1) {
+                lift_path(0, hole);  //根到hole路径上的元素各上移一层，最后一个元素放进hole
+                heap[hole] = std::move(heap[ele_num - 1]);
+            }
+            --ele_num;
+            alloc_traits::destroy(alloc, heap + ele_num);
+        }
+
+        void cancel_pop(pop_plan) {}  //plan_pop没有改动堆
+
+        static size_t frontier_size(size_t k) {
+            return (D - 1) * k + 1;
+        }
+
+        position top_position() const {
+            return 0;
+        }
+
+        const T &value_at(position p) const {
+            return heap[p];
+        }
+
+        template<class F>
+        void for_each_child(position p, F f) const {
+            for (size_t ch = D * p + 1; ch <= D * p + D && ch < ele_num; ++ch) f(ch);
+        }
+
+        //连同分配器一起交换，数组总是和分配它的分配器在一起
+        void swap_content(d_ary_heap &other) {
+            std::swap(heap, other.heap);
+            std::swap(ele_num, other.ele_num);
+            std::swap(capacity, other.capacity);
+            std::swap(cmp, other.cmp);
+            std::swap(alloc, other.alloc);
+        }
+
+        void copy_from(const d_ary_heap &other) {
+            if (other.ele_num == 0) return;
+            heap = alloc_traits::allocate(alloc, other.ele_num);
+            capacity = other.ele_num;
+            try {
+                for (; ele_num < other.ele_num; ++ele_num) {
+                    alloc_traits::construct(alloc, heap + ele_num, other.heap[ele_num]);
+                }
+            } catch (...) {
+                clear();
+                alloc_traits::deallocate(alloc, heap, capacity);
+                heap = nullptr;
+                capacity = 0;
+                throw;
+            }
+        }
+
+        void grow() {
+            reallocate((capacity > 0) ? 2 * capacity : 16);
+        }
+
+        void reallocate(size_t new_capacity) {
+            T *temp = alloc_traits::allocate(alloc, new_capacity);
+            size_t i = 0;
+            try {
+                for (; i < ele_num; ++i) alloc_traits::construct(alloc, temp + i, std::move_if_noexcept(heap[i]));
+            } catch (...) {
+                for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, temp + j);
+                alloc_traits::deallocate(alloc, temp, new_capacity);
+                throw;
+            }
+            for (i = 0; i < ele_num; ++i) alloc_traits::destroy(alloc, heap + i);
+            alloc_traits::deallocate(alloc, heap, capacity);
+            heap = temp;
+            capacity = new_capacity;
+        }
+
+        //heap[pos]可能比祖先大，把它上移到正确位置并返回这个位置。先只比较找到目标位置，再移动元素。
+        size_t sift_up(size_t pos) {
+            size_t target = pos;
+            while (target > 0 && cmp(heap[(target - 1) / D], heap[pos])) target = (target - 1) / D;
+            if (target == pos) return pos;
+            T value = std::move(heap[pos]);
+            for (size_t i = pos; i != target; i = (i - 1) / D) heap[i] = std::move(heap[(i - 1) / D]);
+            heap[target] = std::move(value);
+            return target;
+        }
+
+        //撤销把pos上移到target的sift_up，不做比较
+        void unsift(size_t pos, size_t target) {
+            if (target == pos) return;
+            size_t path[64];
+            size_t len = 0;
+            for (size_t i = pos; i != target; i = (i - 1) / D) path[len++] = i;
+            T value = std::move(heap[target]);
+            size_t up = target;  //路径上的元素各下移一层回到原位
+            for (size_t k = len; k > 0; --k) {
+                heap[up] = std::move(heap[path[k - 1]]);
+                up = path[k - 1];
+            }
+            heap[pos] = std::move(value);
+        }
+
+        //值为value的元素从hole开始下沉应该落在的位置，只考虑前n个元素：
+        //每次走向最大的儿子，直到儿子都不比value大。只做比较，不移动元素。
+        size_t find_hole(size_t hole, const T &value, size_t n) const {
+            while (true) {
+                size_t first = D * hole + 1;
+                if (first >= n) break;
+                size_t best = first;
+                size_t end = (first + D < n) ? first + D : n;
+                for (size_t c = first + 1; c < end; ++c) {
+                    if (cmp(heap[best], heap[c])) best = c;
+                }
+                if (!cmp(value, heap[best])) break;
+                hole = best;
+            }
+            return hole;
+        }
+
+        //top到hole路径上（不含top）的元素各上移一层，heap[top]原来的值被覆盖，heap[hole]成为空位
+        void lift_path(size_t top, size_t hole) {
+            size_t path[64];  //堆的深度不超过log2(size)
+            size_t len = 0;
+            for (size_t i = hole; i != top; i = (i - 1) / D) path[len++] = i;
+            for (size_t k = len; k > 0; --k) heap[(path[k - 1] - 1) / D] = std::move(heap[path[k - 1]]);
+        }
+
+        //heap[pos]可能比儿子小，把它下移到正确位置
+        void sift_down(size_t pos) {
+            size_t hole = find_hole(pos, heap[pos], ele_num);
+            if (hole == pos) return;
+            T value = std::move(heap[pos]);
+            lift_path(pos, hole);
+            heap[hole] = std::move(value);
+        }
+
+        //Floyd建堆：从最后一个有儿子的节点开始倒着下沉，O(n)
+        void heapify() {
+            if (ele_num < 2) return;
+            for (size_t i = (ele_num - 2) / D + 1; i > 0; --i) sift_down(i - 1);
+        }
+    };
+
+}
+
+#endif
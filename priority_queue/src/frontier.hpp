@@ -0,0 +1,85 @@
+#ifndef SJTU_FRONTIER_HPP
+#define SJTU_FRONTIER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace sjtu {
+
+/**
+ * a small binary heap of positions (node pointers or array indices) inside some other heap,
+ *   used to walk that heap best-first without changing it: take the best position,
+ *   then push its children. after k steps it holds O(k) positions, so reading the
+ *   k best elements costs O(klogk) whatever the size of the heap.
+ * Less(a, b) tells whether the element at a is less than the element at b.
+ */
+    template<class Item, class Less, class Allocator>
+    class frontier {
+        static_assert(std::is_trivially_copyable<Item>::value, "frontier only holds positions");
+
+    private:
+        using item_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Item>;
+        using item_traits = std::allocator_traits<item_allocator>;
+
+        item_allocator alloc;
+        Less less;
+        Item *data = nullptr;
+        size_t num = 0;
+        size_t cap = 0;
+
+        void grow(size_t new_cap) {
+            Item *temp = item_traits::allocate(alloc, new_cap);
+            for (size_t i = 0; i < num; ++i) temp[i] = data[i];
+            if (data != nullptr) item_traits::deallocate(alloc, data, cap);
+            data = temp;
+            cap = new_cap;
+        }
+
+    public:
+        frontier(size_t expected, const Less &_less, const Allocator &_alloc) : alloc(_alloc), less(_less) {
+            grow(expected > 0 ? expected : 1);
+        }
+
+        frontier(const frontier &) = delete;
+
+        frontier &operator=(const frontier &) = delete;
+
+        ~frontier() {
+            item_traits::deallocate(alloc, data, cap);
+        }
+
+        bool empty() const {
+            return num == 0;
+        }
+
+        void push(Item x) {
+            if (num == cap) grow(2 * cap);
+            size_t i = num++;
+            while (i > 0 && less(data[(i - 1) / 2], x)) {
+                data[i] = data[(i - 1) / 2];
+                i = (i - 1) / 2;
+            }
+            data[i] = x;
+        }
+
+        //取出最好的位置
+        Item pop() {
+            Item ret = data[0];
+            Item last = data[--num];
+            size_t i = 0;
+            while (2 * i + 1 < num) {
+                size_t c = 2 * i + 1;
+                if (c + 1 < num && less(data[c], data[c + 1])) ++c;
+                if (!less(last, data[c])) break;
+                data[i] = data[c];
+                i = c;
+            }
+            data[i] = last;
+            return ret;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef SJTU_HEAP_OPS_HPP
+#define SJTU_HEAP_OPS_HPP
+
+#include <cstddef>
+#include <utility>
+#include "exceptions.hpp"
+#include "frontier.hpp"
+
+namespace sjtu {
+
+/**
+ * the operations every heap engine (leftist, d-ary, pairing, skew) offers in the same way,
+ *   written once on top of a few private hooks of the engine (CRTP: Derived is the engine).
+ *
+ * if Compare throws, the operation is abandoned and the heap is left as it was:
+ *   every engine decides what to do with comparisons first and moves elements or relinks nodes afterwards.
+ *
+ * Derived makes heap_ops a friend and provides:
+ *   size(), get_allocator() and a member Compare cmp;
+ *   pop_plan plan_pop(): the comparisons of a pop, the heap keeps all its elements in heap order;
+ *   T &top_slot(): the top element, moved out after plan_pop;
+ *   finish_pop(plan): removes the top, does not compare and does not throw;
+ *   cancel_pop(plan): undoes plan_pop when the top could not be moved out;
+ *   position, top_position(), value_at(p), for_each_child(p, f): a read-only walk of the heap.
+ */
+    template<class Derived, typename T, class Compare>
+    class heap_ops {
+    public:
+        /**
+         * delete the top element and return it, moved out of the queue.
+         * if T cannot be moved without throwing it is copied, and an exception leaves the queue unchanged.
+         * throw container_is_empty if empty() returns true;
+         */
+        T pop_value() {
+            Derived &h = self();
+            if (h.size() == 0) throw container_is_empty();
+            typename Derived::pop_plan plan = h.plan_pop();  //失败时堆不变
+            T ret = take_top(h, plan);
+            h.finish_pop(plan);
+            return ret;
+        }
+
+        /**
+         * pop the min(k, size()) top elements into out, best first, and return the end of the output.
+         */
+        template<class OutputIterator>
+        OutputIterator pop_n(size_t k, OutputIterator out) {
+            for (k = (k < self().size()) ? k : self().size(); k > 0; --k) {
+                *out = pop_value();
+                ++out;
+            }
+            return out;
+        }
+
+        /**
+         * copy the min(k, size()) top elements into out, best first, leaving the queue unchanged,
+         *   and return the end of the output.
+         * the heap is walked best-first through a frontier of the positions whose parents were read,
+         *   O(klogk) when every position has a bounded number of children.
+         */
+        template<class OutputIterator>
+        OutputIterator top_k(size_t k, OutputIterator out) const {
+            typedef typename Derived::position position;
+            const Derived &h = self();
+            if (k > h.size()) k = h.size();
+            if (k == 0) return out;
+            Compare c = h.cmp;
+            auto less = [&c, &h](position a, position b) { return c(h.value_at(a), h.value_at(b)); };
+            frontier<position, decltype(less), typename Derived::allocator_type>
+                    f(Derived::frontier_size(k), less, h.get_allocator());
+            f.push(h.top_position());
+            while (true) {
+                position p = f.pop();
+                *out = h.value_at(p);
+                ++out;
+                if (--k == 0) break;
+                h.for_each_child(p, [&f](position ch) { f.push(ch); });
+            }
+            return out;
+        }
+
+    protected:
+        //top_k的frontier预留的大小，孩子多的堆可以改写
+        static size_t frontier_size(size_t k) {
+            return 2 * k;
+        }
+
+    private:
+        Derived &self() {
+            return static_cast<Derived &>(*this);
+        }
+
+        const Derived &self() const {
+            return static_cast<const Derived &>(*this);
+        }
+
+        //取出堆顶的值，失败时撤销plan_pop
+        template<class Plan>
+        static T take_top(Derived &h, Plan &plan) {
+            try {
+                return T(std::move_if_noexcept(h.top_slot()));
+            } catch (...) {
+                h.cancel_pop(plan);
+                throw;
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef SJTU_NODE_POOL_HPP
+#define SJTU_NODE_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * storage for the nodes of one node-based heap.
+ * nodes are carved from slabs obtained through Allocator; a destroyed node goes to a free list
+ *   and is handed out again by the next create(), so a queue in steady state
+ *   (as many pushes as pops) makes no allocator call at all.
+ * slabs are only given back by shrink_to_fit() or the destructor.
+ */
+    template<class Node, class Allocator>
+    class node_pool {
+    private:
+        union slot {
+            slot *next;  //在空闲链表中时指向下一个空闲位置
+            alignas(Node) unsigned char data[sizeof(Node)];
+        };
+
+        struct slab_header {  //放在每个slab的第0个slot中，后面count个slot用来存节点
+            slot *next_slab;
+            size_t count;
+        };
+
+        static_assert(sizeof(slab_header) <= sizeof(slot), "slab header must fit in one slot");
+
+        using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+        using slot_alloc_traits = std::allocator_traits<slot_allocator>;
+
+        static constexpr size_t min_slab = 16;
+        static constexpr size_t max_slab = 4096;
+
+        slot_allocator alloc;
+        slot *slabs = nullptr;
+        slot *free_list = nullptr;
+        slot *free_tail = nullptr;  //为了在merge时O(1)接上另一个池子的空闲链表
+        size_t slab_num = 0;
+        size_t total = 0;     //所有slab中slot的总数
+        size_t free_num = 0;
+
+        static slab_header *header(slot *s) {
+            return reinterpret_cast<slab_header *>(s);
+        }
+
+        void push_free(slot *s) {
+            if (free_list == nullptr) free_tail = s;
+            s->next = free_list;
+            free_list = s;
+            ++free_num;
+        }
+
+        void new_slab(size_t count) {
+            slot *s = slot_alloc_traits::allocate(alloc, count + 1);
+            ::new(static_cast<void *>(s)) slab_header{slabs, count};
+            slabs = s;
+            ++slab_num;
+            total += count;
+            for (size_t i = count; i > 0; --i) push_free(s + i);  //倒序放入，使得先取出的节点地址更小
+        }
+
+        void free_slab(slot *s) {
+            total -= header(s)->count;
+            --slab_num;
+            slot_alloc_traits::deallocate(alloc, s, header(s)->count + 1);
+        }
+
+        void release() {
+            while (slabs != nullptr) {
+                slot *next = header(slabs)->next_slab;
+                free_slab(slabs);
+                slabs = next;
+            }
+            free_list = free_tail = nullptr;
+            free_num = 0;
+        }
+
+    public:
+        explicit node_pool(const Allocator &_alloc = Allocator()) : alloc(_alloc) {}
+
+        node_pool(const node_pool &) = delete;
+
+        /**
+         * take over all the slabs of other, other is left empty.
+         */
+        node_pool(node_pool &&other) noexcept : alloc(std::move(other.alloc)) {
+            swap(other);
+        }
+
+        node_pool &operator=(const node_pool &) = delete;
+
+        ~node_pool() {  //调用时所有节点必须都已经被销毁
+            release();
+        }
+
+        /**
+         * give back all the slabs of this pool and take over those of other.
+         * this pool must have no live node; the allocator is taken over as well
+         *   if it propagates on move assignment, otherwise both pools should use equal allocators.
+         */
+        void take(node_pool &other) {
+            if (this == &other) return;
+            release();
+            if constexpr (slot_alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc = std::move(other.alloc);
+            }
+            swap(other);
+        }
+
+        template<class... Args>
+        Node *create(Args &&... args) {
+            if (free_list == nullptr) {
+                size_t count = total / 2;
+                new_slab(count < min_slab ? min_slab : (count > max_slab ? max_slab : count));
+            }
+            slot *s = free_list;
+            slot *next = s->next;  //构造节点会覆盖掉next
+            Node *p = reinterpret_cast<Node *>(s->data);
+            try {
+                ::new(static_cast<void *>(p)) Node(std::forward<Args>(args)...);
+            } catch (...) {
+                s->next = next;  //构造失败时s仍留在空闲链表中，恢复可能被写坏的next
+                throw;
+            }
+            free_list = next;
+            if (free_list == nullptr) free_tail = nullptr;
+            --free_num;
+            return p;
+        }
+
+        void destroy(Node *p) {
+            p->~Node();
+            push_free(reinterpret_cast<slot *>(p));
+        }
+
+        /**
+         * make sure at least n more nodes can be created without asking the allocator.
+         */
+        void reserve(size_t n) {
+            if (n > free_num) new_slab(n - free_num);
+        }
+
+        /**
+         * give every slab with no live node back to the allocator.
+         */
+        void shrink_to_fit() {
+            if (slab_num == 0) return;
+            std::unique_ptr<slot *[]> order_buf(new slot *[slab_num]);
+            std::unique_ptr<size_t[]> free_buf(new size_t[slab_num]());  //任何一个分配失败时池子还没有被改动
+            slot **order = order_buf.get();
+            size_t *free_in = free_buf.get();
+            std::less<slot *> before;  //不同slab的地址只能用std::less比较
+            size_t k = 0;
+            for (slot *s = slabs; s != nullptr; s = header(s)->next_slab) order[k++] = s;
+            std::sort(order, order + k, before);
+            for (slot *s = free_list; s != nullptr; s = s->next) {  //每个空闲slot属于地址不超过它的最后一个slab
+                ++free_in[std::upper_bound(order, order + k, s, before) - order - 1];
+            }
+            slot *old_free = free_list;
+            free_list = free_tail = nullptr;
+            free_num = 0;
+            for (slot *s = old_free; s != nullptr;) {
+                slot *next = s->next;
+                size_t i = std::upper_bound(order, order + k, s, before) - order - 1;
+                if (free_in[i] != header(order[i])->count) push_free(s);
+                s = next;
+            }
+            slabs = nullptr;
+            for (size_t i = 0; i < k; ++i) {
+                if (free_in[i] == header(order[i])->count) {
+                    free_slab(order[i]);
+                } else {
+                    header(order[i])->next_slab = slabs;
+                    slabs = order[i];
+                }
+            }
+        }
+
+        /**
+         * take over all the slabs of other, together with the nodes living in them.
+         * both pools must use equal allocators.
+         */
+        void splice(node_pool &other) {
+            if (this == &other || other.slabs == nullptr) return;
+            slot *last = other.slabs;
+            while (header(last)->next_slab != nullptr) last = header(last)->next_slab;
+            header(last)->next_slab = slabs;
+            slabs = other.slabs;
+            if (other.free_list != nullptr) {
+                other.free_tail->next = free_list;
+                if (free_list == nullptr) free_tail = other.free_tail;
+                free_list = other.free_list;
+            }
+            slab_num += other.slab_num;
+            total += other.total;
+            free_num += other.free_num;
+            other.slabs = other.free_list = other.free_tail = nullptr;
+            other.slab_num = other.total = other.free_num = 0;
+        }
+
+        void swap(node_pool &other) {
+            std::swap(slabs, other.slabs);
+            std::swap(free_list, other.free_list);
+            std::swap(free_tail, other.free_tail);
+            std::swap(slab_num, other.slab_num);
+            std::swap(total, other.total);
+            std::swap(free_num, other.free_num);
+        }
+
+        /**
+         * number of nodes (live or free) the slabs can hold.
+         */
+        size_t capacity() const {
+            return total;
+        }
+
+        size_t free_count() const {
+            return free_num;
+        }
+
+        size_t slab_count() const {
+            return slab_num;
+        }
+
+        Allocator get_allocator() const {
+            return Allocator(alloc);
+        }
+    };
+
+}
+
+#endif
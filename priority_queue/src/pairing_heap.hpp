@@ -0,0 +1,552 @@
+#ifndef SJTU_PAIRING_HEAP_HPP
+#define SJTU_PAIRING_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "heap_ops.hpp"
+#include "node_pool.hpp"
+
+namespace sjtu {
+
+/**
+ * a pairing heap: every node keeps its children in a list, push and merge
+ *   just link two roots (one comparison, O(1)), pop combines the children of the
+ *   root with the two-pass pairing rule, O(logn) amortized.
+ * raising an element (increase_key) is one comparison plus a cut, O(1) apart from the amortized cost.
+ * Compare works as in priority_queue: top() is the element that is not less than any other.
+ * pop_value, pop_n and top_k come from heap_ops, so does the rule for a throwing Compare;
+ *   top_k has its own cost here, see below.
+ */
+    template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+    class pairing_heap : public heap_ops<pairing_heap<T, Compare, Allocator>, T, Compare> {
+        friend class heap_ops<pairing_heap, T, Compare>;
+
+    private:
+        struct node {
+            T value;
+            node *child;    //第一个儿子
+            node *sibling;  //下一个兄弟
+            node *prev;     //第一个儿子指向父亲，其余指向前一个兄弟
+
+            template<class... Args>
+            explicit node(Args &&... args) : value(std::forward<Args>(args)...), child(nullptr), sibling(nullptr),
+                                             prev(nullptr) {}
+        };
+
+    public:
+        typedef Allocator allocator_type;
+
+        /**
+         * a stable reference to an element in the heap, returned by push.
+         * it stays valid until the element is popped or erased,
+         *   and moves along with the element when its heap is merged into another.
+         */
+        class handle {
+            friend class pairing_heap;
+
+        private:
+            node *ptr = nullptr;
+
+            explicit handle(node *p) : ptr(p) {}
+
+        public:
+            handle() = default;
+
+            const T &operator*() const {
+                return ptr->value;
+            }
+
+            const T *operator->() const {
+                return &ptr->value;
+            }
+
+            bool operator==(const handle &rhs) const {
+                return ptr == rhs.ptr;
+            }
+
+            bool operator!=(const handle &rhs) const {
+                return ptr != rhs.ptr;
+            }
+        };
+
+        pairing_heap() : pairing_heap(Compare()) {}
+
+        explicit pairing_heap(const Compare &comp, const Allocator &alloc = Allocator())
+                : root(nullptr), ele_num(0), cmp(comp), pool(alloc) {}
+
+        explicit pairing_heap(const Allocator &alloc) : pairing_heap(Compare(), alloc) {}
+
+        template<class InputIterator>
+        pairing_heap(InputIterator first, InputIterator last, const Compare &comp = Compare(),
+                     const Allocator &alloc = Allocator())
+                : pairing_heap(comp, alloc) {
+            push_range(first, last);
+        }
+
+        pairing_heap(const pairing_heap &other)
+                : root(nullptr), ele_num(0), cmp(other.cmp),
+                  pool(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                          other.pool.get_allocator())) {
+            root = copy_tree(other.root);
+            ele_num = other.ele_num;
+        }
+
+        /**
+         * take over the nodes of other in O(1), other is left empty.
+         */
+        pairing_heap(pairing_heap &&other) noexcept(std::is_nothrow_move_constructible<Compare>::value)
+                : root(other.root), ele_num(other.ele_num), cmp(std::move(other.cmp)), pool(std::move(other.pool)) {
+            other.root = nullptr;
+            other.ele_num = 0;
+        }
+
+        ~pairing_heap() {
+            clear(root);
+        }
+
+        pairing_heap &operator=(const pairing_heap &other) {
+            if (this == &other) return *this;
+            node *temp = copy_tree(other.root);  //先复制出来，失败时*this保持原样
+            clear(root);
+            root = temp;
+            ele_num = other.ele_num;
+            cmp = other.cmp;
+            return *this;
+        }
+
+        /**
+         * free the own nodes and take over those of other in O(1), other is left empty.
+         * both heaps should use equal allocators, unless the allocator propagates on move assignment.
+         */
+        pairing_heap &operator=(pairing_heap &&other) {
+            if (this == &other) return *this;
+            clear(root);
+            pool.take(other.pool);
+            root = other.root;
+            ele_num = other.ele_num;
+            cmp = std::move(other.cmp);
+            other.root = nullptr;
+            other.ele_num = 0;
+            return *this;
+        }
+
+        /**
+         * get the top of the queue.
+         * @return a reference of the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            if (ele_num == 0) throw container_is_empty();
+            return root->value;
+        }
+
+        /**
+         * push new element to the priority queue.
+         */
+        handle push(const T &e) {
+            return emplace(e);
+        }
+
+        handle push(T &&e) {
+            return emplace(std::move(e));
+        }
+
+        /**
+         * construct a new element in place from args and push it.
+         */
+        template<class... Args>
+        handle emplace(Args &&... args) {
+            node *temp = pool.create(std::forward<Args>(args)...);
+            if (root == nullptr) {
+                root = temp;
+            } else {
+                try {
+                    root = link(root, temp);
+                } catch (...) {
+                    pool.destroy(temp);
+                    throw;
+                }
+            }
+            ++ele_num;
+            return handle(temp);
+        }
+
+        /**
+         * push all the elements of [first, last), one link each, O(m).
+         * if an exception is thrown, the queue is left unchanged.
+         */
+        template<class InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            using category = typename std::iterator_traits<InputIterator>::iterator_category;
+            if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+                pool.reserve(static_cast<size_t>(std::distance(first, last)));
+            }
+            node *tree = nullptr;
+            size_t n = 0;
+            try {
+                for (; first != last; ++first) {
+                    node *temp = pool.create(*first);
+                    if (tree == nullptr) {
+                        tree = temp;
+                    } else {
+                        try {
+                            tree = link(tree, temp);
+                        } catch (...) {
+                            pool.destroy(temp);
+                            throw;
+                        }
+                    }
+                    ++n;
+                }
+                if (tree != nullptr && root != nullptr) tree = link(root, tree);
+            } catch (...) {
+                clear(tree);
+                throw;
+            }
+            if (tree != nullptr) root = tree;
+            ele_num += n;
+        }
+
+        /**
+         * delete the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (ele_num == 0) throw container_is_empty();
+            finish_pop(plan_pop());  //失败时根和它的儿子都还在原处
+        }
+
+        /**
+         * lower the element of h to v, i.e. v is not greater than its current value.
+         * the children of the element are combined and the element is linked back, O(logn) amortized;
+         *   the queue stays correct even if v turns out to be greater.
+         * if Compare throws, nothing changes.
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        void decrease_key(handle h, const T &v) {
+            if (h.ptr == nullptr) throw invalid_iterator();
+            lower(h.ptr, v);
+        }
+
+        /**
+         * raise the element of h to v, i.e. v is not less than its current value.
+         * the element is cut from its parent and linked with the root, O(1) amortized.
+         * if v turns out to be less, it falls back to decrease_key.
+         * if Compare throws, nothing changes.
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        void increase_key(handle h, const T &v) {
+            if (h.ptr == nullptr) throw invalid_iterator();
+            node *x = h.ptr;
+            if (cmp(v, x->value)) {
+                lower(x, v);
+                return;
+            }
+            if (x == root) {
+                x->value = v;
+                return;
+            }
+            bool x_wins = cmp(root->value, v);
+            x->value = v;
+            cut(x);
+            root = x_wins ? attach(x, root) : attach(root, x);
+        }
+
+        /**
+         * remove the element of h from the queue, O(logn) amortized; h becomes invalid.
+         * if Compare throws, nothing changes.
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        void erase(handle h) {
+            if (h.ptr == nullptr) throw invalid_iterator();
+            node *x = h.ptr;
+            if (x == root) {
+                pop();
+                return;
+            }
+            node *sub = combine(x);
+            bool sub_wins = false;
+            try {
+                if (sub != nullptr) sub_wins = cmp(root->value, sub->value);
+            } catch (...) {
+                hang(x, sub);
+                throw;
+            }
+            cut(x);
+            if (sub != nullptr) root = sub_wins ? attach(sub, root) : attach(root, sub);
+            pool.destroy(x);
+            --ele_num;
+        }
+
+        /**
+         * return the number of the elements.
+         */
+        size_t size() const {
+            return ele_num;
+        }
+
+        /**
+         * check if the container has at least an element.
+         * @return true if it is empty, false if it has at least an element.
+         */
+        bool empty() const {
+            return ele_num == 0;
+        }
+
+        /**
+         * merge other into this heap in O(1) and clear other.
+         * the nodes of other are taken over together with their storage,
+         *   so both heaps should use equal allocators.
+         */
+        void merge(pairing_heap &other) {
+            if (this == &other) return;
+            if (root == nullptr) {
+                root = other.root;
+            } else if (other.root != nullptr) {
+                root = link(root, other.root);
+            }
+            pool.splice(other.pool);
+            ele_num += other.ele_num;
+            other.root = nullptr;
+            other.ele_num = 0;
+        }
+
+        /**
+         * copy the min(k, size()) top elements into out, best first, leaving the queue unchanged,
+         *   and return the end of the output.
+         * the children of a node are not ordered among themselves, so all children of every node read
+         *   enter the frontier: O(mlogm) for m children of the k nodes read, and m is not bounded by k.
+         *   after n pushes without a pop the root has n-1 children, so even top_k(2) is O(nlogn);
+         *   a pop pairs the children up again.
+         */
+        template<class OutputIterator>
+        OutputIterator top_k(size_t k, OutputIterator out) const {
+            return heap_ops<pairing_heap, T, Compare>::top_k(k, out);
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return pool.get_allocator();
+        }
+
+        /**
+         * make sure n elements in total can be held without asking the allocator for memory.
+         */
+        void reserve(size_t n) {
+            if (n > ele_num) pool.reserve(n - ele_num);
+        }
+
+        /**
+         * return the memory of popped elements to the allocator.
+         */
+        void shrink_to_fit() {
+            pool.shrink_to_fit();
+        }
+
+        /**
+         * number of elements the queue can hold without asking the allocator for memory.
+         */
+        size_t capacity() const {
+            return pool.capacity();
+        }
+
+    private:
+        node *root;
+        size_t ele_num;
+        Compare cmp;
+        node_pool<node, Allocator> pool;
+
+        //l成为w的第一个儿子，返回w。不做比较。
+        static node *attach(node *w, node *l) {
+            l->sibling = w->child;
+            if (w->child != nullptr) w->child->prev = l;
+            l->prev = w;
+            w->child = l;
+            return w;
+        }
+
+        //连接两个树根，返回新根。比较失败时不做任何改动。
+        node *link(node *a, node *b) {
+            return cmp(a->value, b->value) ? attach(b, a) : attach(a, b);
+        }
+
+        //把树t挂成p的第一个儿子，不做比较，要求t不比p大
+        static void hang(node *p, node *t) {
+            if (t != nullptr) attach(p, t);
+        }
+
+        //heap_ops用到的接口。pop_plan是根的所有儿子合并成的树。
+        typedef node *pop_plan;
+        typedef const node *position;
+
+        pop_plan plan_pop() {
+            return combine(root);
+        }
+
+        T &top_slot() {
+            return root->value;
+        }
+
+        void finish_pop(pop_plan rest) {
+            node *temp = root;
+            root = rest;
+            pool.destroy(temp);
+            --ele_num;
+        }
+
+        void cancel_pop(pop_plan rest) {  //合并好的树挂回根下面
+            hang(root, rest);
+        }
+
+        //儿子之间没有顺序，都要进frontier：代价随读到的k个节点的儿子数增长
+        position top_position() const {
+            return root;
+        }
+
+        static const T &value_at(position p) {
+            return p->value;
+        }
+
+        template<class F>
+        static void for_each_child(position p, F f) {
+            for (const node *ch = p->child; ch != nullptr; ch = ch->sibling) f(ch);
+        }
+
+        //把以x为根的子树从它的父亲那里剪下来
+        static void cut(node *x) {
+            if (x->prev->child == x) x->prev->child = x->sibling;
+            else x->prev->sibling = x->sibling;
+            if (x->sibling != nullptr) x->sibling->prev = x->prev;
+            x->prev = x->sibling = nullptr;
+        }
+
+        //把p的所有儿子两两配对合并：第一遍从左到右两两连接，第二遍从右到左依次连接，返回合并后的树。
+        //比较失败时剩下的各棵树重新挂回p下面，p不比它们中的任何一个小，所以堆仍然合法。
+        node *combine(node *p) {
+            node *first = p->child;
+            p->child = nullptr;
+            node *acc = nullptr;  //第一遍配对的结果，用sibling串成栈，栈顶是最右边的一棵
+            node *res = nullptr;
+            try {
+                while (first != nullptr) {
+                    node *b = first->sibling;
+                    if (b == nullptr) {
+                        first->sibling = acc;
+                        acc = first;
+                        break;
+                    }
+                    node *next = b->sibling;
+                    node *t = link(first, b);
+                    t->sibling = acc;
+                    acc = t;
+                    first = next;
+                }
+                first = nullptr;
+                if (acc == nullptr) return nullptr;
+                res = acc;
+                acc = acc->sibling;
+                while (acc != nullptr) {
+                    node *next = acc->sibling;
+                    res = link(res, acc);
+                    acc = next;
+                }
+            } catch (...) {
+                while (first != nullptr) {
+                    node *next = first->sibling;
+                    attach(p, first);
+                    first = next;
+                }
+                while (acc != nullptr) {
+                    node *next = acc->sibling;
+                    attach(p, acc);
+                    acc = next;
+                }
+                hang(p, res);
+                throw;
+            }
+            res->sibling = res->prev = nullptr;
+            return res;
+        }
+
+        //x的新值v可能比它的儿子小：先把儿子合并成一棵树，比较都做完以后再改指针
+        void lower(node *x, const T &v) {
+            node *sub = combine(x);
+            bool sub_wins = false, new_root = false;
+            try {
+                if (sub != nullptr) sub_wins = cmp(v, sub->value);
+                if (x != root) new_root = cmp(root->value, sub_wins ? sub->value : v);
+                x->value = v;
+            } catch (...) {
+                hang(x, sub);
+                throw;
+            }
+            bool was_root = (x == root);
+            if (!was_root) cut(x);
+            node *t = x;
+            if (sub != nullptr) t = sub_wins ? attach(sub, x) : attach(x, sub);
+            if (was_root) root = t;
+            else root = new_root ? attach(t, root) : attach(root, t);
+        }
+
+        //把child看作左儿子、sibling看作右儿子，prev正好是这棵二叉树上的父亲。
+        //复制时沿prev同步遍历两棵树，不用递归。失败时已复制的部分会被释放。
+        node *copy_tree(const node *src) {
+            if (src == nullptr) return nullptr;
+            node *dst = pool.create(src->value);
+            try {
+                const node *s = src;
+                node *d = dst;
+                while (true) {
+                    if (s->child != nullptr && d->child == nullptr) {
+                        d->child = pool.create(s->child->value);
+                        d->child->prev = d;
+                        s = s->child;
+                        d = d->child;
+                    } else if (s->sibling != nullptr && d->sibling == nullptr) {
+                        d->sibling = pool.create(s->sibling->value);
+                        d->sibling->prev = d;
+                        s = s->sibling;
+                        d = d->sibling;
+                    } else {
+                        if (s == src) break;
+                        s = s->prev;
+                        d = d->prev;
+                    }
+                }
+            } catch (...) {
+                clear(dst);
+                throw;
+            }
+            return dst;
+        }
+
+        //释放以a为根的树（a没有兄弟）：沿prev每次删掉一个叶子，不用递归
+        void clear(node *a) {
+            while (a != nullptr) {
+                if (a->child != nullptr) {
+                    a = a->child;
+                } else if (a->sibling != nullptr) {
+                    a = a->sibling;
+                } else {
+                    node *up = a->prev;
+                    if (up != nullptr) {
+                        if (up->child == a) up->child = nullptr;
+                        else up->sibling = nullptr;
+                    }
+                    pool.destroy(a);
+                    a = up;
+                }
+            }
+        }
+    };
+
+}
+
+#endif
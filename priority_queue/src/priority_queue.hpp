@@ -3,15 +3,97 @@
 
 #include <cstddef>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <type_traits>
 #include "exceptions.hpp"
+#include "allocator.hpp"
+#include "d_ary_heap.hpp"
+#include "node_pool.hpp"
+#include "pairing_heap.hpp"
+#include "skew_heap.hpp"
+#include "bounded_heap.hpp"
+#include "heap_ops.hpp"
 
 namespace sjtu {
 
+/**
+ * policies choosing the heap behind priority_queue.
+ * leftist_heap_policy: a mergeable node-based leftist heap, merge is O(logn).
+ * d_ary_heap_policy<D>: an implicit D-ary heap in one array, cache friendly, merge is not logarithmic.
+ * pairing_heap_policy: a pairing heap, push, merge and increase_key are O(1), pop is O(logn) amortized.
+ * skew_heap_policy: a skew heap, the smallest nodes, every operation is O(logn) amortized.
+ * bounded_heap_policy: keeps only the best N elements, N is given to the constructor;
+ *   a push that would not be kept is rejected with two comparisons.
+ */
+    struct leftist_heap_policy {
+    };
+
+    struct pairing_heap_policy {
+    };
+
+    struct skew_heap_policy {
+    };
+
+    struct bounded_heap_policy {
+    };
+
+    template<size_t D = 4>
+    struct d_ary_heap_policy {
+    };
+
 /**
  * a container like std::priority_queue which is a heap internal.
+ * pop_value, pop_n and top_k come from heap_ops, so does the rule for a throwing Compare.
 */
-    template<typename T, class Compare=std::less<T>>  //std::less是一个类，它有成员函数std::less::operator()，；返回一个bool值。left<right时返回true。
-    class priority_queue {   //priority_queue的左堆实现
+    template<typename T, class Compare=std::less<T>,
+            class Allocator=std::allocator<T>, class Policy=leftist_heap_policy>  //std::less是一个类，它有成员函数std::less::operator()，；返回一个bool值。left<right时返回true。
+    class priority_queue   //priority_queue的左堆实现
+            : public heap_ops<priority_queue<T, Compare, Allocator, Policy>, T, Compare> {
+        static_assert(std::is_same<Policy, leftist_heap_policy>::value, "unknown priority_queue policy");
+
+        friend class heap_ops<priority_queue, T, Compare>;
+
+    private:
+        struct node;
+
+    public:
+        typedef Allocator allocator_type;
+
+        /**
+         * a stable reference to an element in the queue, returned by push.
+         * it stays valid until the element is popped or erased,
+         *   and moves along with the element when its queue is merged into another.
+         */
+        class handle {
+            friend class priority_queue;
+
+        private:
+            node *ptr = nullptr;
+
+            explicit handle(node *p) : ptr(p) {}
+
+        public:
+            handle() = default;
+
+            const T &operator*() const {
+                return ptr->value;
+            }
+
+            const T *operator->() const {
+                return &ptr->value;
+            }
+
+            bool operator==(const handle &rhs) const {
+                return ptr == rhs.ptr;
+            }
+
+            bool operator!=(const handle &rhs) const {
+                return ptr != rhs.ptr;
+            }
+        };
+
     private:
         struct node {
             int npt;
@@ -20,66 +102,267 @@ namespace sjtu {
             node *right_son;
             node *father;
 
-            node(int _npt, T _value, node *_l, node *_r, node *_f) : npt(_npt), value(_value), left_son(_l),
-                                                                     right_son(_r), father(_f) {}
-
-            node() : npt(0), left_son(nullptr), right_son(nullptr), father(nullptr) {}
+            template<class... Args>
+            explicit node(Args &&... args) : npt(0), value(std::forward<Args>(args)...), left_son(nullptr),
+                                             right_son(nullptr), father(nullptr) {}
         };
 
+        using alloc_traits = std::allocator_traits<Allocator>;
+
         node *root;
         size_t ele_num;
         Compare cmp;
+        node_pool<node, Allocator> pool;  //所有节点都从这个池子中取，pop掉的节点回到池子里重复使用
+
+        template<class... Args>
+        node *create_node(Args &&... args) {
+            return pool.create(std::forward<Args>(args)...);
+        }
+
+        void destroy_node(node *p) {
+            pool.destroy(p);
+        }
 
 
-        void creat(node *a, node *const b) {
-            if (b->left_son == nullptr && b->right_son == nullptr) return;
-            if (b->left_son != nullptr) {
-                if (a->left_son == nullptr) {
-                    a->left_son = new node(b->left_son->npt, b->left_son->value, nullptr, nullptr, a);
+        //复制以src为根的子树，沿father指针同步遍历两棵树，不用递归。失败时已复制的部分会被释放。
+        node *copy_tree(const node *src) {
+            if (src == nullptr) return nullptr;
+            node *dst = create_node(src->value);
+            dst->npt = src->npt;
+            try {
+                const node *s = src;
+                node *d = dst;
+                while (true) {
+                    if (s->left_son != nullptr && d->left_son == nullptr) {
+                        d->left_son = create_node(s->left_son->value);
+                        s = s->left_son;
+                        d->left_son->father = d;
+                        d = d->left_son;
+                        d->npt = s->npt;
+                    } else if (s->right_son != nullptr && d->right_son == nullptr) {
+                        d->right_son = create_node(s->right_son->value);
+                        s = s->right_son;
+                        d->right_son->father = d;
+                        d = d->right_son;
+                        d->npt = s->npt;
+                    } else {
+                        if (s == src) break;
+                        s = s->father;
+                        d = d->father;
+                    }
+                }
+            } catch (...) {
+                clear(dst);
+                throw;
+            }
+            return dst;
+        }
+
+        //两棵非空左偏树合并，返回新的根。
+        //合并后的右链就是两条右链按优先级归并的结果：先只做比较记下归并顺序，再修改指针，
+        //所以比较抛出异常时两棵树都保持原样。右链长度不超过log2(n+1)，128足够。
+        node *merge_node(node *a, node *b) {
+            bool take_b[128];
+            size_t len = 0;
+            for (node *x = a, *y = b; x != nullptr && y != nullptr;) {
+                if (cmp(x->value, y->value)) {
+                    take_b[len++] = true;
+                    y = y->right_son;
                 } else {
-                    a->left_son->npt = b->left_son->npt;
-                    a->left_son->value = b->left_son->value;
+                    take_b[len++] = false;
+                    x = x->right_son;
                 }
-                creat(a->left_son, b->left_son);
             }
-            if (b->right_son != nullptr) {
-                if (a->right_son == nullptr) {
-                    a->right_son = new node(b->right_son->npt, b->right_son->value, nullptr, nullptr, a);
+            node *top = nullptr, *tail = nullptr;
+            for (size_t i = 0; i < len; ++i) {
+                node *cur;
+                if (take_b[i]) {
+                    cur = b;
+                    b = b->right_son;
+                } else {
+                    cur = a;
+                    a = a->right_son;
+                }
+                if (tail == nullptr) {
+                    top = cur;
+                    cur->father = nullptr;
                 } else {
-                    a->right_son->npt = b->right_son->npt;
-                    a->right_son->value = b->right_son->value;
+                    tail->right_son = cur;
+                    cur->father = tail;
                 }
-                creat(a->right_son, b->right_son);
+                tail = cur;
             }
+            node *rest = (a != nullptr) ? a : b;  //剩下的那条右链整体接上
+            tail->right_son = rest;
+            if (rest != nullptr) rest->father = tail;
+            for (node *p = tail;; p = p->father) {  //自下而上维护右链上每个节点的npt，必要时交换左右儿子
+                int l = (p->left_son != nullptr) ? p->left_son->npt : -1;
+                int r = (p->right_son != nullptr) ? p->right_son->npt : -1;
+                if (l < r) {
+                    node *temp = p->left_son;
+                    p->left_son = p->right_son;
+                    p->right_son = temp;
+                    r = l;
+                }
+                p->npt = r + 1;
+                if (p == top) break;
+            }
+            return top;
         }
 
-        void merge_node(node *&a, node *&b) {   //默认两个指针都非空
-            if (cmp(a->value, b->value)) {   //保证a是根节点
-                node *temp1 = a, *dad = a->father;
-                a = b;
-                b = temp1;
-                a->father = dad;
-                b->father = nullptr;
+        //p的一个儿子被换成了另一棵树：自下而上重新计算npt，必要时交换左右儿子，npt不再变化时停止
+        void fix_up(node *p) {
+            for (; p != nullptr; p = p->father) {
+                int l = (p->left_son != nullptr) ? p->left_son->npt : -1;
+                int r = (p->right_son != nullptr) ? p->right_son->npt : -1;
+                if (l < r) {
+                    node *temp = p->left_son;
+                    p->left_son = p->right_son;
+                    p->right_son = temp;
+                    r = l;
+                }
+                if (p->npt == r + 1) break;
+                p->npt = r + 1;
             }
+        }
+
+        //把p的两个儿子合并成一棵树返回，p的指针还没有改。比较失败时不做任何改动。
+        node *merge_children(node *p) {
+            if (p->right_son != nullptr) return merge_node(p->left_son, p->right_son);
+            if (p->left_son != nullptr) p->left_son->father = nullptr;  //左偏树没有左儿子时也没有右儿子
+            return p->left_son;
+        }
+
+        //heap_ops用到的接口。pop_plan是根的两个儿子合并成的树。
+        typedef node *pop_plan;
+        typedef const node *position;
+
+        pop_plan plan_pop() {
+            return merge_children(root);
+        }
+
+        T &top_slot() {
+            return root->value;
+        }
+
+        void finish_pop(pop_plan rest) {
+            node *temp = root;
+            root = rest;
+            destroy_node(temp);
+            --ele_num;
+        }
+
+        void cancel_pop(pop_plan rest) {  //合并好的子树作为唯一的儿子挂回去
+            root->left_son = rest;
+            root->right_son = nullptr;
+            root->npt = 0;
+            if (rest != nullptr) rest->father = root;
+        }
+
+        position top_position() const {
+            return root;
+        }
+
+        static const T &value_at(position p) {
+            return p->value;
+        }
 
-            if (a->right_son != nullptr) {
-                merge_node(a->right_son, b);
+        template<class F>
+        static void for_each_child(position p, F f) {
+            if (p->left_son != nullptr) f(p->left_son);
+            if (p->right_son != nullptr) f(p->right_son);
+        }
+
+        //把x从树中摘下来，它的两个儿子合并后接到它原来的位置，返回合并后的子树。比较失败时不做任何改动。
+        node *unlink(node *x) {
+            node *sub = merge_children(x);
+            node *dad = x->father;
+            if (sub != nullptr) sub->father = dad;
+            if (dad == nullptr) {
+                root = sub;
             } else {
-                a->right_son = b;
-                b->father = a;
-            }
-            node *temp = a->right_son;  //维护左堆的性质
-            if (a->left_son != nullptr) {   //有可能父亲节点没有左儿子
-                a->npt = ((a->right_son->npt < a->left_son->npt) ? a->right_son->npt : a->left_son->npt) + 1;
-                if (a->left_son->npt < a->right_son->npt) {  //交换父节点的左右儿子
-                    a->right_son = a->left_son;
-                    a->left_son = temp;
+                if (dad->left_son == x) dad->left_son = sub;
+                else dad->right_son = sub;
+                fix_up(dad);
+            }
+            x->left_son = x->right_son = x->father = nullptr;
+            x->npt = 0;
+            return sub;
+        }
+
+        //撤销unlink：x接回dad下面sub所在的位置，sub成为x唯一的儿子。只改指针，不做比较。
+        void relink(node *x, node *dad, node *sub) {
+            x->left_son = sub;
+            x->right_son = nullptr;
+            x->npt = 0;
+            x->father = dad;
+            if (sub != nullptr) sub->father = x;
+            if (dad == nullptr) {
+                root = x;
+                return;
+            }
+            //sub为空时它原来的位置是dad的空儿子，fix_up之后空儿子总在右边（两个都空时在左边）
+            bool left = (sub != nullptr) ? dad->left_son == sub : dad->left_son == nullptr;
+            if (left) dad->left_son = x;
+            else dad->right_son = x;
+            fix_up(dad);
+        }
+
+        //新值先拷贝出来，x摘下后与新值交换再合并回去；失败时换回旧值，x接回原处
+        void change_key(handle h, const T &v) {
+            if (h.ptr == nullptr) throw invalid_iterator();
+            node *x = h.ptr;
+            T value(v);
+            node *dad = x->father;
+            node *sub = unlink(x);  //失败时堆不变
+            using std::swap;
+            swap(x->value, value);
+            try {
+                root = (root == nullptr) ? x : merge_node(root, x);
+            } catch (...) {  //merge_node失败时不会改动两棵树
+                swap(x->value, value);
+                relink(x, dad, sub);
+                throw;
+            }
+        }
+
+        //把[first, last)建成一棵左偏树，n加上元素个数。每个元素先单独成为一棵树排进队列，
+        //每次取出队首的两棵合并后放回队尾，总共O(n)。队列用各树根的father指针串起来。
+        template<class InputIterator>
+        node *build(InputIterator first, InputIterator last, size_t &n) {
+            using category = typename std::iterator_traits<InputIterator>::iterator_category;
+            if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+                pool.reserve(static_cast<size_t>(std::distance(first, last)));
+            }
+            node *head = nullptr, *tail = nullptr;
+            size_t cnt = 0;
+            try {
+                for (; first != last; ++first) {
+                    node *p = create_node(*first);
+                    if (tail == nullptr) head = p;
+                    else tail->father = p;
+                    tail = p;
+                    ++cnt;
                 }
-            } else {
-                a->right_son = nullptr;
-                a->left_son = temp;
-                a->npt = 0;
+                while (head != tail) {
+                    node *next = head->father->father;
+                    node *t = merge_node(head, head->father);  //失败时队列保持原样
+                    head = next;
+                    if (head == nullptr) head = t;
+                    else tail->father = t;
+                    tail = t;
+                }
+            } catch (...) {
+                while (head != nullptr) {
+                    node *next = head->father;
+                    head->father = nullptr;
+                    clear(head);
+                    head = next;
+                }
+                throw;
             }
+            n += cnt;
+            return head;
         }
 
 
@@ -87,27 +370,52 @@ namespace sjtu {
         /**
          * TODO constructors
          */
-        priority_queue() {
+        priority_queue() : priority_queue(Compare()) {}
+
+        explicit priority_queue(const Compare &comp, const Allocator &alloc = Allocator())
+                : cmp(comp), pool(alloc) {
             ele_num = 0;
             root = nullptr;
         }
 
+        explicit priority_queue(const Allocator &alloc) : priority_queue(Compare(), alloc) {}
+
+        /**
+         * build the queue from [first, last) in O(n) by pairwise merging.
+         */
+        template<class InputIterator>
+        priority_queue(InputIterator first, InputIterator last, const Compare &comp = Compare(),
+                       const Allocator &alloc = Allocator())
+                : priority_queue(comp, alloc) {
+            push_range(first, last);
+        }
+
 //        explicit priority_queue(const T &ele) {  //只有一个元素的优先队列
 //            ele_num = 1;
 //            root = new node(0, ele, nullptr, nullptr, nullptr);
 //        }
 
-        priority_queue(const priority_queue &other) {
+        priority_queue(const priority_queue &other)
+                : cmp(other.cmp),
+                  pool(alloc_traits::select_on_container_copy_construction(other.pool.get_allocator())) {
+            root = copy_tree(other.root);
             ele_num = other.ele_num;
-            root = new node(other.root->npt, other.root->value, nullptr, nullptr, nullptr);
-            creat(root, other.root);
+        }
+
+        /**
+         * take over the nodes of other in O(1), other is left empty.
+         */
+        priority_queue(priority_queue &&other) noexcept(std::is_nothrow_move_constructible<Compare>::value)
+                : root(other.root), ele_num(other.ele_num), cmp(std::move(other.cmp)), pool(std::move(other.pool)) {
+            other.root = nullptr;
+            other.ele_num = 0;
         }
 
         /**
          * TODO deconstructor
          */
         ~priority_queue() {
-            clear(root);   //clear以后root会变成nullptr!!!!!!!!!
+            clear(root);
             root = nullptr;
         }
 
@@ -116,14 +424,27 @@ namespace sjtu {
          */
         priority_queue &operator=(const priority_queue &other) {
             if (this == &other) return *this;
+            node *temp = copy_tree(other.root);  //先复制出来，失败时*this保持原样
+            clear(root);
+            root = temp;
             ele_num = other.ele_num;
-            if (root == nullptr) {
-                root = new node(other.root->npt, other.root->value, nullptr, nullptr, nullptr);
-            } else {
-                root->npt = other.root->npt;
-                root->value = other.root->value;
-            }
-            creat(root, other.root);
+            cmp = other.cmp;
+            return *this;
+        }
+
+        /**
+         * free the own nodes and take over those of other in O(1), other is left empty.
+         * both queues should use equal allocators, unless the allocator propagates on move assignment.
+         */
+        priority_queue &operator=(priority_queue &&other) {
+            if (this == &other) return *this;
+            clear(root);
+            pool.take(other.pool);
+            root = other.root;
+            ele_num = other.ele_num;
+            cmp = std::move(other.cmp);
+            other.root = nullptr;
+            other.ele_num = 0;
             return *this;
         }
 
@@ -141,28 +462,87 @@ namespace sjtu {
          * TODO
          * push new element to the priority queue.
          */
-        void push(const T &e) {
-            if (ele_num == 0) {
-                if (root == nullptr) {
-                    root = new node(0, e, nullptr, nullptr, nullptr);
-                } else {
-                    root->left_son = nullptr;
-                    root->right_son = nullptr;
-                    root->father = nullptr;
-                    root->value = e;
-                    root->npt = 0;
+        handle push(const T &e) {
+            return emplace(e);
+        }
+
+        handle push(T &&e) {
+            return emplace(std::move(e));
+        }
+
+        /**
+         * construct a new element in place from args and push it.
+         */
+        template<class... Args>
+        handle emplace(Args &&... args) {
+            node *temp = create_node(std::forward<Args>(args)...);
+            if (root == nullptr) {
+                root = temp;
+            } else {
+                try {
+                    root = merge_node(root, temp);
+                } catch (...) {  //merge_node失败时不会改动两棵树
+                    destroy_node(temp);
+                    throw;
                 }
-                ++ele_num;
+            }
+            ++ele_num;
+            return handle(temp);
+        }
+
+        /**
+         * lower the element of h to v, i.e. v is not greater than its current value.
+         * the element is taken out and merged back in, O(logn),
+         *   so the queue stays correct even if v turns out to be greater.
+         * if an exception is thrown, the element keeps its old value, h stays valid and
+         *   the queue holds the same elements (as long as swapping two T does not throw).
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        void decrease_key(handle h, const T &v) {
+            change_key(h, v);
+        }
+
+        /**
+         * raise the element of h to v, i.e. v is not less than its current value.
+         * same cost and guarantees as decrease_key.
+         */
+        void increase_key(handle h, const T &v) {
+            change_key(h, v);
+        }
+
+        /**
+         * remove the element of h from the queue in O(logn); h becomes invalid.
+         * if Compare throws, nothing changes.
+         * throw invalid_iterator if h is a default-constructed handle.
+         */
+        void erase(handle h) {
+            if (h.ptr == nullptr) throw invalid_iterator();
+            unlink(h.ptr);
+            destroy_node(h.ptr);
+            --ele_num;
+        }
+
+        /**
+         * push all the elements of [first, last) in O(m + logn).
+         * they are first built into a heap of their own, which is then merged in.
+         * if an exception is thrown, the queue is left unchanged.
+         */
+        template<class InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            size_t n = 0;
+            node *tree = build(first, last, n);
+            if (tree == nullptr) return;
+            if (root == nullptr) {
+                root = tree;
             } else {
-                node *temp = new node(0, e, nullptr, nullptr, nullptr);
                 try {
-                    merge_node(root, temp);
-                    ++ele_num;
+                    root = merge_node(root, tree);
                 } catch (...) {
-                    delete temp;
+                    clear(tree);
                     throw;
                 }
             }
+            ele_num += n;
         }
 
         /**
@@ -172,19 +552,36 @@ namespace sjtu {
          */
         void pop() {
             if (ele_num == 0) throw container_is_empty();
-            node *temp = root;
-            if (root->right_son != nullptr) {
-                root->left_son->father = nullptr;
-                root->right_son->father = nullptr;
-                merge_node(root->left_son, root->right_son);
-                root = root->left_son;
-            } else if (root->left_son != nullptr) {
-                root = root->left_son;
-                root->father = nullptr;
-            }
-            delete temp;   //不把根节点删掉
-            --ele_num;
-            if (ele_num == 0) root = nullptr;
+            finish_pop(plan_pop());
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return pool.get_allocator();
+        }
+
+        /**
+         * make sure n elements in total can be held without asking the allocator for memory.
+         */
+        void reserve(size_t n) {
+            if (n > ele_num) pool.reserve(n - ele_num);
+        }
+
+        /**
+         * return the memory of popped elements to the allocator.
+         * node storage that still holds an element is kept, so this frees everything only when empty.
+         */
+        void shrink_to_fit() {
+            pool.shrink_to_fit();
+        }
+
+        /**
+         * number of elements the queue can hold without asking the allocator for memory.
+         */
+        size_t capacity() const {
+            return pool.capacity();
         }
 
         /**
@@ -202,20 +599,39 @@ namespace sjtu {
             return ele_num == 0;
         }
 
-        void clear(node *a) {    //typename是告诉编译器priority_queue<T>::node是一个类型 保证root不会变成nullptr
-            if (a == nullptr) return;
-            if (a->left_son != nullptr) clear(a->left_son);
-            if (a->right_son != nullptr) clear(a->right_son);
-            delete a;
-            a = nullptr;
+        void clear(node *a) {    //释放以a为根的子树：沿father指针每次删掉一个叶子，不用递归
+            node *top = (a != nullptr) ? a->father : nullptr;
+            while (a != top) {
+                if (a->left_son != nullptr) {
+                    a = a->left_son;
+                } else if (a->right_son != nullptr) {
+                    a = a->right_son;
+                } else {
+                    node *dad = a->father;
+                    if (dad != nullptr) {
+                        if (dad->left_son == a) dad->left_son = nullptr;
+                        else dad->right_son = nullptr;
+                    }
+                    destroy_node(a);
+                    a = dad;
+                }
+            }
         }
 
         /**
          * merge two priority_queues with at least O(logn) complexity.
          * clear the other priority_queue.
+         * the nodes of other are taken over together with their storage,
+         *   so both queues should use equal allocators.
          */
         void merge(priority_queue &other) {
-            merge_node(root, other.root);
+            if (this == &other) return;
+            if (root == nullptr) {
+                root = other.root;
+            } else if (other.root != nullptr) {
+                root = merge_node(root, other.root);  //可能抛出异常，所以之后再接管other的节点存储
+            }
+            pool.splice(other.pool);
             ele_num += other.ele_num;
             other.root = nullptr;
             other.ele_num = 0;
@@ -224,6 +640,44 @@ namespace sjtu {
 
     };
 
+/**
+ * priority_queue on an array-backed d-ary heap, see d_ary_heap.hpp.
+ * elements move around in the array, so this engine offers no handles.
+ */
+    template<typename T, class Compare, class Allocator, size_t D>
+    class priority_queue<T, Compare, Allocator, d_ary_heap_policy<D>> : public d_ary_heap<T, Compare, Allocator, D> {
+    public:
+        using d_ary_heap<T, Compare, Allocator, D>::d_ary_heap;
+    };
+
+/**
+ * priority_queue on a pairing heap, see pairing_heap.hpp.
+ */
+    template<typename T, class Compare, class Allocator>
+    class priority_queue<T, Compare, Allocator, pairing_heap_policy> : public pairing_heap<T, Compare, Allocator> {
+    public:
+        using pairing_heap<T, Compare, Allocator>::pairing_heap;
+    };
+
+/**
+ * priority_queue on a skew heap, see skew_heap.hpp. it offers no handles.
+ */
+    template<typename T, class Compare, class Allocator>
+    class priority_queue<T, Compare, Allocator, skew_heap_policy> : public skew_heap<T, Compare, Allocator> {
+    public:
+        using skew_heap<T, Compare, Allocator>::skew_heap;
+    };
+
+/**
+ * priority_queue keeping only the best N elements, see bounded_heap.hpp.
+ * it has no default constructor: N must be given, e.g. priority_queue<int, std::less<int>,
+ *   std::allocator<int>, bounded_heap_policy> q(100);
+ */
+    template<typename T, class Compare, class Allocator>
+    class priority_queue<T, Compare, Allocator, bounded_heap_policy> : public bounded_heap<T, Compare, Allocator> {
+    public:
+        using bounded_heap<T, Compare, Allocator>::bounded_heap;
+    };
 
 }
 
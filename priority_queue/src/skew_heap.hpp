@@ -0,0 +1,447 @@
+#ifndef SJTU_SKEW_HEAP_HPP
+#define SJTU_SKEW_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "heap_ops.hpp"
+#include "node_pool.hpp"
+
+namespace sjtu {
+
+/**
+ * a skew heap: a leftist heap without npt.
+ * merge walks down the two right spines and swaps the children of every node on the way,
+ *   O(logn) amortized for push, pop and merge. a node is just a value and two pointers.
+ * Compare works as in priority_queue: top() is the element that is not less than any other.
+ * pop_value, pop_n and top_k come from heap_ops, so does the rule for a throwing Compare.
+ */
+    template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+    class skew_heap : public heap_ops<skew_heap<T, Compare, Allocator>, T, Compare> {
+        friend class heap_ops<skew_heap, T, Compare>;
+
+    private:
+        struct node {
+            T value;
+            node *left_son;
+            node *right_son;
+            bool run_end;  //合并时使用：这个节点之后改从另一条右链上取节点
+
+            template<class... Args>
+            explicit node(Args &&... args) : value(std::forward<Args>(args)...), left_son(nullptr), right_son(nullptr),
+                                             run_end(false) {}
+        };
+
+    public:
+        typedef Allocator allocator_type;
+
+        skew_heap() : skew_heap(Compare()) {}
+
+        explicit skew_heap(const Compare &comp, const Allocator &alloc = Allocator())
+                : root(nullptr), ele_num(0), cmp(comp), pool(alloc) {}
+
+        explicit skew_heap(const Allocator &alloc) : skew_heap(Compare(), alloc) {}
+
+        template<class InputIterator>
+        skew_heap(InputIterator first, InputIterator last, const Compare &comp = Compare(),
+                  const Allocator &alloc = Allocator())
+                : skew_heap(comp, alloc) {
+            push_range(first, last);
+        }
+
+        skew_heap(const skew_heap &other)
+                : root(nullptr), ele_num(0), cmp(other.cmp),
+                  pool(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                          other.pool.get_allocator())) {
+            root = copy_tree(other.root);
+            ele_num = other.ele_num;
+        }
+
+        /**
+         * take over the nodes of other in O(1), other is left empty.
+         */
+        skew_heap(skew_heap &&other) noexcept(std::is_nothrow_move_constructible<Compare>::value)
+                : root(other.root), ele_num(other.ele_num), cmp(std::move(other.cmp)), pool(std::move(other.pool)) {
+            other.root = nullptr;
+            other.ele_num = 0;
+        }
+
+        ~skew_heap() {
+            clear(root);
+        }
+
+        skew_heap &operator=(const skew_heap &other) {
+            if (this == &other) return *this;
+            node *temp = copy_tree(other.root);  //先复制出来，失败时*this保持原样
+            clear(root);
+            root = temp;
+            ele_num = other.ele_num;
+            cmp = other.cmp;
+            return *this;
+        }
+
+        /**
+         * free the own nodes and take over those of other in O(1), other is left empty.
+         * both heaps should use equal allocators, unless the allocator propagates on move assignment.
+         */
+        skew_heap &operator=(skew_heap &&other) {
+            if (this == &other) return *this;
+            clear(root);
+            pool.take(other.pool);
+            root = other.root;
+            ele_num = other.ele_num;
+            cmp = std::move(other.cmp);
+            other.root = nullptr;
+            other.ele_num = 0;
+            return *this;
+        }
+
+        /**
+         * get the top of the queue.
+         * @return a reference of the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        const T &top() const {
+            if (ele_num == 0) throw container_is_empty();
+            return root->value;
+        }
+
+        /**
+         * push new element to the priority queue.
+         */
+        void push(const T &e) {
+            emplace(e);
+        }
+
+        void push(T &&e) {
+            emplace(std::move(e));
+        }
+
+        /**
+         * construct a new element in place from args and push it.
+         */
+        template<class... Args>
+        void emplace(Args &&... args) {
+            node *temp = pool.create(std::forward<Args>(args)...);
+            if (root == nullptr) {
+                root = temp;
+            } else {
+                try {
+                    root = merge_node(root, temp);
+                } catch (...) {
+                    pool.destroy(temp);
+                    throw;
+                }
+            }
+            ++ele_num;
+        }
+
+        /**
+         * push all the elements of [first, last) in O(m) amortized:
+         *   they are merged pairwise, round after round, into one heap which is then merged in.
+         * if an exception is thrown, the queue is left unchanged.
+         */
+        template<class InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            using category = typename std::iterator_traits<InputIterator>::iterator_category;
+            if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+                pool.reserve(static_cast<size_t>(std::distance(first, last)));
+            }
+            node *head = nullptr;  //新节点先用right_son串成一条链
+            size_t n = 0;
+            try {
+                for (; first != last; ++first) {
+                    node *temp = pool.create(*first);
+                    temp->right_son = head;
+                    head = temp;
+                    ++n;
+                }
+            } catch (...) {
+                clear(head);
+                throw;
+            }
+            if (n == 0) return;
+            using ptr_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node *>;
+            using ptr_traits = std::allocator_traits<ptr_allocator>;
+            ptr_allocator ptr_alloc(pool.get_allocator());
+            node **trees;
+            try {
+                trees = ptr_traits::allocate(ptr_alloc, n);
+            } catch (...) {
+                clear(head);
+                throw;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                trees[i] = head;
+                head = head->right_son;
+                trees[i]->right_son = nullptr;
+            }
+            size_t m = n, i = 0, done = 0;  //第i、i+1棵合并后放到第done个位置
+            try {
+                while (m > 1) {
+                    for (i = 0, done = 0; i + 1 < m; i += 2) trees[done++] = merge_node(trees[i], trees[i + 1]);
+                    if (i < m) trees[done++] = trees[i];
+                    m = done;
+                    i = done = 0;
+                }
+                if (root != nullptr) trees[0] = merge_node(root, trees[0]);
+            } catch (...) {  //[0, done)和[i, m)中是还没有合并完的树
+                for (size_t k = 0; k < done; ++k) clear(trees[k]);
+                for (size_t k = i; k < m; ++k) clear(trees[k]);
+                ptr_traits::deallocate(ptr_alloc, trees, n);
+                throw;
+            }
+            root = trees[0];
+            ele_num += n;
+            ptr_traits::deallocate(ptr_alloc, trees, n);
+        }
+
+        /**
+         * delete the top element.
+         * throw container_is_empty if empty() returns true;
+         */
+        void pop() {
+            if (ele_num == 0) throw container_is_empty();
+            finish_pop(plan_pop());
+        }
+
+        /**
+         * return the number of the elements.
+         */
+        size_t size() const {
+            return ele_num;
+        }
+
+        /**
+         * check if the container has at least an element.
+         * @return true if it is empty, false if it has at least an element.
+         */
+        bool empty() const {
+            return ele_num == 0;
+        }
+
+        /**
+         * merge other into this heap in O(logn) amortized and clear other.
+         * the nodes of other are taken over together with their storage,
+         *   so both heaps should use equal allocators.
+         */
+        void merge(skew_heap &other) {
+            if (this == &other) return;
+            if (root == nullptr) {
+                root = other.root;
+            } else if (other.root != nullptr) {
+                root = merge_node(root, other.root);
+            }
+            pool.splice(other.pool);
+            ele_num += other.ele_num;
+            other.root = nullptr;
+            other.ele_num = 0;
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return pool.get_allocator();
+        }
+
+        /**
+         * make sure n elements in total can be held without asking the allocator for memory.
+         */
+        void reserve(size_t n) {
+            if (n > ele_num) pool.reserve(n - ele_num);
+        }
+
+        /**
+         * return the memory of popped elements to the allocator.
+         */
+        void shrink_to_fit() {
+            pool.shrink_to_fit();
+        }
+
+        /**
+         * number of elements the queue can hold without asking the allocator for memory.
+         */
+        size_t capacity() const {
+            return pool.capacity();
+        }
+
+    private:
+        node *root;
+        size_t ele_num;
+        Compare cmp;
+        node_pool<node, Allocator> pool;
+
+        //把p的两个儿子合并成一棵树返回，p的指针还没有改。比较失败时不做任何改动。
+        node *merge_children(node *p) {
+            if (p->left_son == nullptr) return p->right_son;
+            if (p->right_son == nullptr) return p->left_son;
+            return merge_node(p->left_son, p->right_son);
+        }
+
+        //heap_ops用到的接口。pop_plan是根的两个儿子合并成的树。
+        typedef node *pop_plan;
+        typedef const node *position;
+
+        pop_plan plan_pop() {
+            return merge_children(root);
+        }
+
+        T &top_slot() {
+            return root->value;
+        }
+
+        void finish_pop(pop_plan rest) {
+            node *temp = root;
+            root = rest;
+            pool.destroy(temp);
+            --ele_num;
+        }
+
+        void cancel_pop(pop_plan rest) {  //合并好的子树作为唯一的儿子挂回去
+            root->left_son = rest;
+            root->right_son = nullptr;
+        }
+
+        position top_position() const {
+            return root;
+        }
+
+        static const T &value_at(position p) {
+            return p->value;
+        }
+
+        template<class F>
+        static void for_each_child(position p, F f) {
+            if (p->left_son != nullptr) f(p->left_son);
+            if (p->right_son != nullptr) f(p->right_son);
+        }
+
+        //两棵非空斜堆合并，返回新的根。合并的结果是两条右链按优先级归并，路上每个节点交换左右儿子。
+        //斜堆的右链可能很长，不能像左偏树那样把归并顺序存进定长数组：第一遍只做比较，
+        //在每一段连续取自同一条右链的节点的最后一个上打run_end标记；第二遍按标记改指针。
+        //比较抛出异常时沿同样的路线清掉标记，两棵树保持原样。
+        node *merge_node(node *a, node *b) {
+            size_t len = 0;
+            bool first_from_b = false, last_from_b = false;
+            node *last = nullptr;
+            try {
+                for (node *x = a, *y = b; x != nullptr && y != nullptr; ++len) {
+                    bool from_b = cmp(x->value, y->value);
+                    if (last == nullptr) first_from_b = from_b;
+                    else if (from_b != last_from_b) last->run_end = true;
+                    if (from_b) {
+                        last = y;
+                        y = y->right_son;
+                    } else {
+                        last = x;
+                        x = x->right_son;
+                    }
+                    last_from_b = from_b;
+                }
+            } catch (...) {
+                bool from_b = first_from_b;
+                for (size_t i = 0; i < len; ++i) {
+                    node *w;
+                    if (from_b) {
+                        w = b;
+                        b = b->right_son;
+                    } else {
+                        w = a;
+                        a = a->right_son;
+                    }
+                    if (w->run_end) {
+                        w->run_end = false;
+                        from_b = !from_b;
+                    }
+                }
+                throw;
+            }
+            node *top = nullptr;
+            node **slot = &top;  //下一个节点要接到的位置
+            bool from_b = first_from_b;
+            for (size_t i = 0; i < len; ++i) {
+                node *w;
+                if (from_b) {
+                    w = b;
+                    b = b->right_son;
+                } else {
+                    w = a;
+                    a = a->right_son;
+                }
+                if (w->run_end) {
+                    w->run_end = false;
+                    from_b = !from_b;
+                }
+                *slot = w;
+                w->right_son = w->left_son;  //原来的左子树换到右边，归并的结果接在左边
+                slot = &w->left_son;
+            }
+            *slot = (a != nullptr) ? a : b;
+            return top;
+        }
+
+        //没有父亲指针，也不用栈：新建的节点在还没处理时，left_son暂存对应的源节点，
+        //right_son把所有待处理的节点串成一个链表。失败时已复制的部分会被释放。
+        node *copy_tree(const node *src) {
+            if (src == nullptr) return nullptr;
+            node *dst = pool.create(src->value);
+            dst->left_son = const_cast<node *>(src);
+            node *pending = dst;
+            try {
+                while (pending != nullptr) {
+                    node *d = pending;
+                    const node *s = d->left_son;
+                    pending = d->right_son;
+                    d->left_son = d->right_son = nullptr;
+                    if (s->left_son != nullptr) {
+                        node *c = pool.create(s->left_son->value);
+                        c->left_son = s->left_son;
+                        c->right_son = pending;
+                        pending = c;
+                        d->left_son = c;
+                    }
+                    if (s->right_son != nullptr) {
+                        node *c = pool.create(s->right_son->value);
+                        c->left_son = s->right_son;
+                        c->right_son = pending;
+                        pending = c;
+                        d->right_son = c;
+                    }
+                }
+            } catch (...) {
+                while (pending != nullptr) {
+                    node *next = pending->right_son;
+                    pending->left_son = pending->right_son = nullptr;
+                    pending = next;
+                }
+                clear(dst);
+                throw;
+            }
+            return dst;
+        }
+
+        //释放以a为根的树：有左儿子时右旋，把左儿子转到上面；没有左儿子时删掉根，继续处理右子树
+        void clear(node *a) {
+            while (a != nullptr) {
+                if (a->left_son != nullptr) {
+                    node *l = a->left_son;
+                    a->left_son = l->right_son;
+                    l->right_son = a;
+                    a = l;
+                } else {
+                    node *next = a->right_son;
+                    pool.destroy(a);
+                    a = next;
+                }
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+// compare sjtu::small_vector<int, 16> with plain sjtu::vector<int>.
+// not part of the test suite, build it by hand with optimization, e.g.
+//     g++ -std=c++17 -O2 -I../src small.cpp -o small && ./small
+// for each size s, many short-lived vectors are filled with s elements, read back and destroyed,
+//     as a container of rows or a map from keys to small vectors would do.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "vector.hpp"
+
+namespace {
+
+    volatile long long sink;
+
+    template<class F>
+    double timed(F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template<class V>
+    double run(size_t size, size_t rounds) {
+        return timed([=] {
+            long long sum = 0;
+            for (size_t r = 0; r < rounds; ++r) {
+                V v;
+                for (size_t i = 0; i < size; ++i) v.push_back(static_cast<int>(r + i));
+                for (size_t i = 0; i < v.size(); ++i) sum += v[i];
+            }
+            sink = sum;
+        });
+    }
+
+}
+
+int main(int argc, char **argv) {
+    size_t elements = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 50000000;
+    std::printf("%zu elements per size, time in ms\n", elements);
+    std::printf("%-6s %12s %12s\n", "size", "vector", "small<16>");
+    for (size_t size = 1; size <= 64; size *= 2) {
+        size_t rounds = elements / size;
+        double plain = run<sjtu::vector<int>>(size, rounds);
+        double small = run<sjtu::small_vector<int, 16>>(size, rounds);
+        std::printf("%-6zu %12.1f %12.1f\n", size, plain, small);
+    }
+    return 0;
+}
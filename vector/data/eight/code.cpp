@@ -0,0 +1,66 @@
+#include "vector.hpp"
+
+#include <iostream>
+
+typedef sjtu::vector<int, std::allocator<int>, 0, sjtu::bounds_check::always> checked_vector;
+
+template<class F>
+void expect_throw(F f)
+{
+	try {
+		f();
+		std::cout << "no throw ";
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound ";
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid_iterator ";
+	}
+}
+
+void TestAlwaysChecked()
+{
+	std::cout << "Testing bounds_check::always..." << std::endl;
+	checked_vector v;
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i * 10);
+	}
+	const checked_vector &cv = v;
+	std::cout << v[4] << " " << cv[0] << std::endl;
+	expect_throw([&] { v[5]; });
+	expect_throw([&] { cv[100]; });
+	expect_throw([&] { v.at(5); });
+	std::cout << std::endl;
+	v.unchecked(2) = 21;
+	std::cout << cv.unchecked(2) << " " << (v.data() == &v[0]) << " " << cv.data()[4] << std::endl;
+	int sum = 0;
+	for (const int *p = cv.data(); p != cv.data() + cv.size(); ++p) {
+		sum += *p;
+	}
+	std::cout << sum << std::endl;
+}
+
+void TestEraseChecked()
+{
+	std::cout << "Testing erase at a bad position..." << std::endl;
+	checked_vector v, other;
+	v.reserve(16);
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i);
+	}
+	other.push_back(1);
+	expect_throw([&] { v.erase(v.end()); });
+	expect_throw([&] { v.erase(v.begin() + 7); });
+	expect_throw([&] { v.erase(other.begin()); });
+	expect_throw([&] { v.erase(5); });
+	std::cout << std::endl;
+	std::cout << v.size() << std::endl;
+	checked_vector::iterator it = v.erase(v.begin() + 4);
+	std::cout << (it == v.end()) << " " << *v.erase(v.begin()) << " " << v.size() << std::endl;
+}
+
+int main()
+{
+	TestAlwaysChecked();
+	TestEraseChecked();
+	return 0;
+}
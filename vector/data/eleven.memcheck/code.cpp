@@ -0,0 +1,92 @@
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+typedef sjtu::vector<int, std::allocator<int>, 0, sjtu::bounds_check::always> checked_vector;
+typedef sjtu::vector<int, std::allocator<int>, 0, sjtu::bounds_check::never> unchecked_vector;
+
+unsigned rand_next() {
+	static unsigned reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) >> 1;
+}
+
+template<class V>
+void print(const V &v)
+{
+	for (typename V::const_iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << "| size = " << v.size() << std::endl;
+}
+
+template<class V>
+void TestAlgorithms(const char *name)
+{
+	std::cout << "Testing standard algorithms on " << name << "..." << std::endl;
+	typedef typename V::iterator iterator;
+	typedef typename V::const_iterator const_iterator;
+	std::cout << std::is_same<typename std::iterator_traits<iterator>::iterator_category,
+	                          std::random_access_iterator_tag>::value << std::endl;
+	V v;
+	for (int i = 0; i < 12; ++i) {
+		v.push_back((i * 7) % 12);
+	}
+	std::sort(v.begin(), v.end());
+	print(v);
+	std::reverse(v.begin(), v.end());
+	print(v);
+	std::sort(v.begin() + 2, v.end() - 2);
+	print(v);
+	std::reverse(v.begin(), v.begin() + 5);
+	std::sort(v.begin(), v.end());
+	const V &cv = v;
+	const_iterator lo = std::lower_bound(cv.begin(), cv.end(), 5);
+	iterator hi = std::upper_bound(v.begin(), v.end(), 8);
+	std::cout << *lo << " " << (lo - cv.begin()) << " " << (hi - v.begin()) << " "
+	          << (std::lower_bound(v.begin(), v.end(), 100) == v.end()) << std::endl;
+	std::cout << std::binary_search(cv.begin(), cv.end(), 11) << " "
+	          << std::binary_search(cv.begin(), cv.end(), 12) << std::endl;
+	V big;
+	for (int i = 0; i < 20000; ++i) {
+		big.push_back(rand_next() % 100000);
+	}
+	std::sort(big.begin(), big.end());
+	bool ok = std::is_sorted(big.begin(), big.end());
+	for (int i = 0; i < 1000; ++i) {
+		int x = rand_next() % 100000;
+		iterator it = std::lower_bound(big.begin(), big.end(), x);
+		ok = ok && (it == big.end() || *it >= x) && (it == big.begin() || *(it - 1) < x);
+	}
+	std::reverse(big.begin(), big.end());
+	ok = ok && std::is_sorted(big.begin(), big.end(), std::greater<int>());
+	std::cout << (ok ? "ok." : "wrong.") << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing standard algorithms on strings..." << std::endl;
+	sjtu::vector<std::string> v;
+	const char *words[] = {"pear", "apple", "fig", "plum", "kiwi", "banana"};
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(words[i]);
+	}
+	std::sort(v.begin(), v.end());
+	print(v);
+	std::reverse(v.begin(), v.end());
+	print(v);
+	std::cout << *std::lower_bound(v.begin(), v.end(), std::string("grape"), std::greater<std::string>()) << std::endl;
+}
+
+int main()
+{
+	TestAlgorithms<checked_vector>("a checked vector");
+	TestAlgorithms<unchecked_vector>("an unchecked vector");
+	TestAlgorithms<sjtu::small_vector<int, 8>>("a small_vector");
+	TestStrings();
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << "| size = " << v.size() << std::endl;
+}
+
+void TestSmallVector()
+{
+	std::cout << "Testing small_vector..." << std::endl;
+	sjtu::small_vector<int, 4> v;
+	std::cout << v.capacity() << std::endl;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(i);
+	}
+	print(v);
+	std::cout << v.capacity() << std::endl;
+	v.push_back(4);
+	v.insert(v.begin(), -1);
+	v.insert(v.begin(), -1);
+	print(v);
+	std::cout << (v.capacity() >= 7) << std::endl;
+	sjtu::small_vector<int, 4> w(v);
+	for (int i = 0; i < 4; ++i) {
+		v.erase(v.begin());
+	}
+	v.shrink_to_fit();
+	print(v);
+	std::cout << v.capacity() << std::endl;
+	print(w);
+	w = v;
+	print(w);
+	sjtu::small_vector<std::string, 2> s;
+	s.push_back("inline");
+	s.push_back("still");
+	s.push_back("heap");
+	sjtu::small_vector<std::string, 2> t(std::move(s));
+	print(t);
+	t.pop_back();
+	t.shrink_to_fit();
+	print(t);
+	std::cout << t.capacity() << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestSmallVector();
+	return 0;
+}
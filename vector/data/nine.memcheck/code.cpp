@@ -0,0 +1,63 @@
+#include "vector.hpp"
+
+#include <iostream>
+
+// bounds_check::debug只在没有定义NDEBUG时检查下标，两种编译方式下输出都一样
+typedef sjtu::vector<int, std::allocator<int>, 0, sjtu::bounds_check::debug> debug_vector;
+
+#ifdef NDEBUG
+const bool debug_build = false;
+#else
+const bool debug_build = true;
+#endif
+
+void TestDebugChecked()
+{
+	std::cout << "Testing bounds_check::debug..." << std::endl;
+	debug_vector v;
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(i * i);
+	}
+	v.reserve(16);
+	bool thrown = false;
+	try {
+		v[8];
+	} catch (sjtu::index_out_of_bound &) {
+		thrown = true;
+	}
+	std::cout << (thrown == debug_build ? "ok." : "wrong.") << std::endl;
+	try {
+		v.at(8);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at() throws correctly." << std::endl;
+	}
+	std::cout << v[7] << " " << v.unchecked(3) << " " << v.data()[2] << std::endl;
+	const debug_vector &cv = v;
+	long long sum = 0;
+	for (size_t i = 0; i < cv.size(); ++i) {
+		sum += cv.unchecked(i) + cv[i];
+	}
+	std::cout << sum << std::endl;
+}
+
+void TestEraseDebug()
+{
+	std::cout << "Testing erase at a bad position..." << std::endl;
+	debug_vector v;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(i);
+	}
+	try {
+		v.erase(v.end());
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	std::cout << *v.erase(v.begin() + 1) << " " << v.size() << std::endl;
+}
+
+int main()
+{
+	TestDebugChecked();
+	TestEraseDebug();
+	return 0;
+}
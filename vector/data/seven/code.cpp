@@ -0,0 +1,134 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << "| size = " << v.size() << std::endl;
+}
+
+// 记录分配次数的分配器
+template<class T>
+struct counting_allocator : std::allocator<T> {
+	static int allocations;
+
+	template<class U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator() = default;
+
+	template<class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(size_t n) {
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+template<class T>
+int counting_allocator<T>::allocations = 0;
+
+void TestEmpty()
+{
+	std::cout << "Testing empty vectors..." << std::endl;
+	typedef sjtu::vector<int, counting_allocator<int>> counted;
+	counted a, b(a);
+	counted c;
+	c = a;
+	std::cout << a.capacity() << " " << b.capacity() << " " << c.capacity() << " "
+	          << counting_allocator<int>::allocations << std::endl;
+	a.push_back(1);
+	std::cout << (a.capacity() >= 1) << " " << counting_allocator<int>::allocations << std::endl;
+}
+
+void TestGrowth()
+{
+	std::cout << "Testing capacity growth..." << std::endl;
+	sjtu::vector<int> v;
+	size_t last = v.capacity();
+	int changes = 0;
+	bool ok = true;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+		ok = ok && v.capacity() >= v.size();
+		if (v.capacity() != last) {
+			++changes;
+			last = v.capacity();
+		}
+	}
+	std::cout << (ok ? "ok." : "wrong.") << " " << (changes <= 11) << std::endl;
+	sjtu::vector<int> r;
+	r.reserve(500);
+	const int *before = r.data();
+	for (int i = 0; i < 500; ++i) {
+		r.push_back(i);
+	}
+	std::cout << r.capacity() << " " << (r.data() == before) << std::endl;
+	r.reserve(100);
+	std::cout << r.capacity() << std::endl;
+}
+
+void TestShrink()
+{
+	std::cout << "Testing shrink_to_fit..." << std::endl;
+	sjtu::vector<std::string> v;
+	v.reserve(64);
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(std::string(i + 1, 'a' + i));
+	}
+	std::cout << v.capacity() << std::endl;
+	v.shrink_to_fit();
+	std::cout << v.capacity() << std::endl;
+	print(v);
+	v.push_back("f");
+	print(v);
+	v.clear();
+	v.shrink_to_fit();
+	std::cout << v.capacity() << " " << v.empty() << std::endl;
+}
+
+void TestResize()
+{
+	std::cout << "Testing resize..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 1; i <= 10; ++i) {
+		v.push_back(i);
+	}
+	size_t cap = v.capacity();
+	v.resize(3);
+	print(v);
+	std::cout << (v.capacity() == cap) << std::endl;
+	v.resize(6);
+	print(v);
+	v.resize(8, 7);
+	print(v);
+	v.resize(20, v[0]);
+	print(v);
+	v.resize(0);
+	print(v);
+	sjtu::vector<std::string> s;
+	s.resize(3);
+	s[1] = "mid";
+	s.resize(4, "end");
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << "[" << s[i] << "]";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestEmpty();
+	TestGrowth();
+	TestShrink();
+	TestResize();
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <string>
+
+template<class V>
+void print(const V &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << "| size = " << v.size() << std::endl;
+}
+
+void TestRangeInsert()
+{
+	std::cout << "Testing range insert..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i);
+	}
+	int a[] = {10, 11, 12};
+	sjtu::vector<int>::iterator it = v.insert(v.begin() + 2, a, a + 3);
+	std::cout << *it << std::endl;
+	print(v);
+	std::list<int> l = {20, 21};
+	v.insert(v.end(), l.begin(), l.end());
+	print(v);
+	std::istringstream in("30 31 32");
+	v.insert(0, std::istream_iterator<int>(in), std::istream_iterator<int>());
+	print(v);
+	v.insert(v.begin() + 1, 3, 7);
+	print(v);
+	v.insert(4, 2, 8);
+	print(v);
+	it = v.insert(v.begin(), a, a);
+	std::cout << *it << std::endl;
+	try {
+		v.insert(100, a, a + 3);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	print(v);
+}
+
+void TestRangeErase()
+{
+	std::cout << "Testing range erase..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(i + 1, 'a' + i));
+	}
+	sjtu::vector<std::string>::iterator it = v.erase(v.begin() + 2, v.begin() + 5);
+	std::cout << *it << std::endl;
+	print(v);
+	it = v.erase(v.begin() + 4, v.end());
+	std::cout << (it == v.end()) << std::endl;
+	print(v);
+	v.erase(v.begin(), v.begin());
+	print(v);
+	v.erase(v.begin(), v.end());
+	std::cout << v.empty() << std::endl;
+}
+
+void TestAppendAssign()
+{
+	std::cout << "Testing append and assign..." << std::endl;
+	sjtu::vector<int> v;
+	int a[] = {1, 2, 3};
+	v.append(a, a + 3);
+	print(v);
+	std::list<int> l = {4, 5};
+	v.append(l);
+	print(v);
+	v.append(v);
+	print(v);
+	v.assign(l.begin(), l.end());
+	print(v);
+	v.assign(a);
+	print(v);
+	v.assign(4, 9);
+	print(v);
+	v.assign(2, v[0]);
+	print(v);
+	v.assign(v);
+	print(v);
+	v.assign(a, a);
+	std::cout << v.empty() << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestRangeInsert();
+	TestRangeErase();
+	TestAppendAssign();
+	return 0;
+}
@@ -0,0 +1,54 @@
+#define SJTU_VECTOR_BOUNDS_CHECK never
+#include "vector.hpp"
+
+#include <iostream>
+#include <type_traits>
+
+// 通过宏把默认的检查方式设为never：operator[]不检查，迭代器就是指针
+void TestNeverChecked()
+{
+	std::cout << "Testing bounds_check::never..." << std::endl;
+	sjtu::vector<double> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i * 0.5);
+	}
+	std::cout << std::is_same<sjtu::vector<double>::iterator, double *>::value << " "
+	          << std::is_same<sjtu::vector<double>::const_iterator, const double *>::value << std::endl;
+	double sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i] + v.unchecked(i);
+	}
+	std::cout << sum << " " << (v.data() + 3 == &v[3]) << " " << (v.begin() == v.data()) << std::endl;
+	try {
+		v.at(10);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at() throws correctly." << std::endl;
+	}
+}
+
+void TestEraseNever()
+{
+	std::cout << "Testing erase at a bad position..." << std::endl;
+	sjtu::vector<double> v;
+	v.reserve(8);
+	v.push_back(1.5);
+	v.push_back(2.5);
+	try {
+		v.erase(v.end());
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	try {
+		v.erase(v.begin() + 3);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "Throw correctly." << std::endl;
+	}
+	std::cout << *v.erase(v.begin()) << " " << v.size() << std::endl;
+}
+
+int main()
+{
+	TestNeverChecked();
+	TestEraseNever();
+	return 0;
+}
@@ -2,20 +2,112 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "allocator.hpp"
 
+#include <algorithm>
 #include <climits>
 #include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
+/**
+ * whether a T can be moved to another address by a plain memcpy of its bytes
+ *   (the old bytes are then simply forgotten, no destructor is run on them).
+ * true for every trivially copyable type; specialize it to true_type for your
+ *   own types that only hold pointers to the heap (no pointer into itself).
+ */
+    template<typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * when vector::operator[] checks its index.
+ * always: throw index_out_of_bound on a bad index, as the course spec asks.
+ * debug: check only when NDEBUG is not defined, like assert.
+ * never: no check at all, operator[] is as cheap as unchecked().
+ * at() always checks whatever the policy.
+ * the default comes from the macro SJTU_VECTOR_BOUNDS_CHECK, e.g. -DSJTU_VECTOR_BOUNDS_CHECK=never.
+ */
+    enum class bounds_check {
+        always, debug, never
+    };
+
+#ifndef SJTU_VECTOR_BOUNDS_CHECK
+#define SJTU_VECTOR_BOUNDS_CHECK always
+#endif
+
+    constexpr bounds_check default_bounds_check = bounds_check::SJTU_VECTOR_BOUNDS_CHECK;
+
+/**
+ * room for N elements inside the vector object itself, see small_vector.
+ * the N == 0 specialization is empty and takes no space in vector.
+ */
+    template<typename T, size_t N>
+    struct inline_buffer {
+        alignas(T) unsigned char bytes[N * sizeof(T)];
+
+        T *inline_data() {
+            return reinterpret_cast<T *>(bytes);
+        }
+
+        const T *inline_data() const {
+            return reinterpret_cast<const T *>(bytes);
+        }
+    };
+
+    template<typename T>
+    struct inline_buffer<T, 0> {
+        T *inline_data() {
+            return nullptr;
+        }
+
+        const T *inline_data() const {
+            return nullptr;
+        }
+    };
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * memory is obtained from Allocator, e.g. std::allocator or sjtu::arena_allocator.
+ * with Inline > 0 the first Inline elements are kept inside the object and the
+ *   Allocator is only used beyond that, see small_vector below.
+ * Check decides whether operator[] checks its index, see bounds_check.
  */
-    template<typename T>
-    class vector {
+    template<typename T, class Allocator = std::allocator<T>, size_t Inline = 0,
+            bounds_check Check = default_bounds_check>
+    class vector : private inline_buffer<T, Inline> {
+    private:
+#ifdef NDEBUG
+        static constexpr bool checked = (Check == bounds_check::always);
+        static constexpr bool checked_iterators = false;  //release模式下迭代器总是指针
+#else
+        static constexpr bool checked = (Check != bounds_check::never);
+        static constexpr bool checked_iterators = checked;
+#endif
 
     public:
+        using allocator_type = Allocator;
+
+        /**
+         * without NDEBUG, iterators and const_iterators check that two of them come from the same vector
+         *   when subtracted, unless Check is never.
+         * in release mode (NDEBUG defined, whatever Check) and with Check == never they are plain
+         *   T * and const T *, so that the standard algorithms take their pointer fast paths
+         *   (memmove, vectorized loops); operator[] still follows Check.
+         * either way they are contiguous random-access iterators.
+         */
+        class checked_iterator;
+
+        class checked_const_iterator;
+
+        using iterator = typename std::conditional<checked_iterators, checked_iterator, T *>::type;
+        using const_iterator = typename std::conditional<checked_iterators, checked_const_iterator, const T *>::type;
+
         /**
          * TODO
          * a type for actions of the elements of a vector, and you should write
@@ -24,9 +116,7 @@ namespace sjtu {
         /**
          * you can see RandomAccessIterator at CppReference for help.
          */
-        class const_iterator;
-
-        class iterator {
+        class checked_iterator {
             // The following code is written for the C++ type_traits library.
             // Type traits is a C++ feature for describing certain properties of a type.
             // For instance, for an iterator, iterator::value_type is the type that the
@@ -43,42 +133,47 @@ namespace sjtu {
             using value_type = T;
             using pointer = T *;
             using reference = T &;
-            using iterator_category = std::output_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
             pointer ptr;
-            vector<value_type> *vec_ptr;
+            vector *vec_ptr;
 
         public:
             /**
              * return a new iterator which pointer n-next elements
              * as well as operator-
              */
-            iterator() : ptr(nullptr), vec_ptr(nullptr) {}
+            checked_iterator() : ptr(nullptr), vec_ptr(nullptr) {}
 
-            iterator(pointer _ptr, vector<value_type> *_vec_ptr) : ptr(_ptr), vec_ptr(_vec_ptr) {}
+            checked_iterator(pointer _ptr, vector *_vec_ptr) : ptr(_ptr), vec_ptr(_vec_ptr) {}
 
-            iterator operator+(const int &n) const {  //todo 迭代器越界是否要抛出错误
-                iterator new_iter(ptr + n, vec_ptr);
-                return new_iter;
+            checked_iterator operator+(difference_type n) const {  //todo 迭代器越界是否要抛出错误
+                return checked_iterator(ptr + n, vec_ptr);
             }
 
-            iterator operator-(const int &n) const {
-                iterator new_iter(ptr - n, vec_ptr);
-                return new_iter;
+            friend checked_iterator operator+(difference_type n, const checked_iterator &it) {
+                return it + n;
+            }
+
+            checked_iterator operator-(difference_type n) const {
+                return checked_iterator(ptr - n, vec_ptr);
             }
 
             // return the distance between two iterators,
             // if these two iterators point to different vectors, throw invalid_iterator.
-            int operator-(const iterator &rhs) const {
+            difference_type operator-(const checked_iterator &rhs) const {
                 if (vec_ptr != rhs.vec_ptr) throw invalid_iterator();
                 return ptr - rhs.ptr;
             }
 
-            iterator &operator+=(const int &n) {
+            checked_iterator &operator+=(difference_type n) {
                 ptr += n;
                 return *this;
             }
 
-            iterator &operator-=(const int &n) {
+            checked_iterator &operator-=(difference_type n) {
                 ptr -= n;
                 return *this;
             }
@@ -86,8 +181,8 @@ namespace sjtu {
             /**
              * TODO iter++
              */
-            iterator operator++(int) {
-                iterator new_iter(ptr, vec_ptr);
+            checked_iterator operator++(int) {
+                checked_iterator new_iter(ptr, vec_ptr);
                 ptr++;
                 return new_iter;
             }
@@ -95,7 +190,7 @@ namespace sjtu {
             /**
              * TODO ++iter
              */
-            iterator &operator++() {
+            checked_iterator &operator++() {
                 ptr++;
                 return *this;
             }
@@ -103,8 +198,8 @@ namespace sjtu {
             /**
              * TODO iter--
              */
-            iterator operator--(int) {
-                iterator new_iter(ptr, vec_ptr);
+            checked_iterator operator--(int) {
+                checked_iterator new_iter(ptr, vec_ptr);
                 ptr--;
                 return new_iter;
             }
@@ -112,7 +207,7 @@ namespace sjtu {
             /**
              * TODO --iter
              */
-            iterator &operator--() {
+            checked_iterator &operator--() {
                 ptr--;
                 return *this;
             }
@@ -124,71 +219,93 @@ namespace sjtu {
                 return *ptr;
             }
 
+            T *operator->() const {
+                return ptr;
+            }
+
+            T &operator[](difference_type n) const {
+                return *(ptr + n);
+            }
+
             /**
              * a operator to check whether two iterators are same (pointing to the same memory address).
+             * the other comparisons order iterators of the same vector by position.
              */
-            bool operator==(const iterator &rhs) const {
+            bool operator==(const checked_iterator &rhs) const {
                 return ptr == rhs.ptr;
             }
 
-            bool operator==(const const_iterator &rhs) const {
-                return ptr == rhs.ptr;
+            bool operator!=(const checked_iterator &rhs) const {
+                return ptr != rhs.ptr;
             }
 
-            /**
-             * some other operator for iterator.
-             */
-            bool operator!=(const iterator &rhs) const {
-                return ptr !=rhs.ptr;
+            bool operator<(const checked_iterator &rhs) const {
+                return ptr < rhs.ptr;
             }
 
-            bool operator!=(const const_iterator &rhs) const {
-                return ptr != rhs.ptr;
+            bool operator>(const checked_iterator &rhs) const {
+                return ptr > rhs.ptr;
+            }
+
+            bool operator<=(const checked_iterator &rhs) const {
+                return ptr <= rhs.ptr;
+            }
+
+            bool operator>=(const checked_iterator &rhs) const {
+                return ptr >= rhs.ptr;
             }
         };
 
         /**
          * TODO
          * has same function as iterator, just for a const object.
+         * an iterator converts to it, and the two can be compared with each other.
          */
-        class const_iterator {
+        class checked_const_iterator {
         public:
             using difference_type = std::ptrdiff_t;
             using value_type = T;
-            using pointer = T *;
-            using reference = T &;
-            using iterator_category = std::output_iterator_tag;
+            using pointer = const T *;
+            using reference = const T &;
+            using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
             pointer ptr;
-            const vector<value_type> *vec_ptr;
+            const vector *vec_ptr;
 
         public:
-            const_iterator() : ptr(nullptr), vec_ptr(nullptr) {}
+            checked_const_iterator() : ptr(nullptr), vec_ptr(nullptr) {}
 
-            const_iterator(pointer _ptr, const vector<value_type> *_vec_ptr) : ptr(_ptr), vec_ptr(_vec_ptr) {}
+            checked_const_iterator(pointer _ptr, const vector *_vec_ptr) : ptr(_ptr), vec_ptr(_vec_ptr) {}
 
-            const_iterator operator+(const int &n) const {  //todo 迭代器越界是否要抛出错误
-                const_iterator new_iter(ptr + n, vec_ptr);
-                return new_iter;
+            checked_const_iterator(const checked_iterator &it) : ptr(it.ptr), vec_ptr(it.vec_ptr) {}
+
+            checked_const_iterator operator+(difference_type n) const {  //todo 迭代器越界是否要抛出错误
+                return checked_const_iterator(ptr + n, vec_ptr);
             }
 
-            const_iterator operator-(const int &n) const {
-                const_iterator new_iter(ptr - n, vec_ptr);
-                return new_iter;
+            friend checked_const_iterator operator+(difference_type n, const checked_const_iterator &it) {
+                return it + n;
+            }
+
+            checked_const_iterator operator-(difference_type n) const {
+                return checked_const_iterator(ptr - n, vec_ptr);
             }
 
             // return the distance between two iterators,
             // if these two iterators point to different vectors, throw invaild_iterator.
-            int operator-(const iterator &rhs) const {
+            difference_type operator-(const checked_const_iterator &rhs) const {
                 if (vec_ptr != rhs.vec_ptr) throw invalid_iterator();
                 return ptr - rhs.ptr;
             }
 
-            const_iterator &operator+=(const int &n) {
+            checked_const_iterator &operator+=(difference_type n) {
                 ptr += n;
                 return *this;
             }
 
-            const_iterator &operator-=(const int &n) {
+            checked_const_iterator &operator-=(difference_type n) {
                 ptr -= n;
                 return *this;
             }
@@ -196,8 +313,8 @@ namespace sjtu {
             /**
              * TODO iter++
              */
-            const_iterator operator++(int) {
-                const_iterator new_iter(ptr, vec_ptr);
+            checked_const_iterator operator++(int) {
+                checked_const_iterator new_iter(ptr, vec_ptr);
                 ptr++;
                 return new_iter;
             }
@@ -205,7 +322,7 @@ namespace sjtu {
             /**
              * TODO ++iter
              */
-            const_iterator &operator++() {
+            checked_const_iterator &operator++() {
                 ptr++;
                 return *this;
             }
@@ -213,8 +330,8 @@ namespace sjtu {
             /**
              * TODO iter--
              */
-            const_iterator operator--(int) {
-                const_iterator new_iter(ptr, vec_ptr);
+            checked_const_iterator operator--(int) {
+                checked_const_iterator new_iter(ptr, vec_ptr);
                 ptr--;
                 return new_iter;
             }
@@ -222,7 +339,7 @@ namespace sjtu {
             /**
              * TODO --iter
              */
-            const_iterator &operator--() {
+            checked_const_iterator &operator--() {
                 ptr--;
                 return *this;
             }
@@ -230,53 +347,92 @@ namespace sjtu {
             /**
              * TODO *it
              */
-            T &operator*() const {
+            const T &operator*() const {
                 return *ptr;
             }
 
+            const T *operator->() const {
+                return ptr;
+            }
+
+            const T &operator[](difference_type n) const {
+                return *(ptr + n);
+            }
+
             /**
              * a operator to check whether two iterators are same (pointing to the same memory address).
+             * an iterator on either side is converted to a const_iterator.
              */
-            bool operator==(const iterator &rhs) const {
-                return ptr == rhs.ptr;
+            friend bool operator==(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr == rhs.ptr;
             }
 
-            bool operator==(const const_iterator &rhs) const {
-                return ptr == rhs.ptr;
+            friend bool operator!=(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr != rhs.ptr;
             }
 
-            /**
-             * some other operator for iterator.
-             */
-            bool operator!=(const iterator &rhs) const {
-                return ptr != rhs.ptr;
+            friend bool operator<(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr < rhs.ptr;
             }
 
-            bool operator!=(const const_iterator &rhs) const {
-                return ptr != rhs.ptr;
+            friend bool operator>(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr > rhs.ptr;
+            }
+
+            friend bool operator<=(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr <= rhs.ptr;
+            }
+
+            friend bool operator>=(const checked_const_iterator &lhs, const checked_const_iterator &rhs) {
+                return lhs.ptr >= rhs.ptr;
             }
         };
 
+    private:
+        //只接受iterator本身。release模式下iterator是指针，写成模板才不会让insert(0, x)把0当成空指针而产生歧义
+        template<class It>
+        using if_iterator = typename std::enable_if<std::is_same<It, iterator>::value, iterator>::type;
+
+        //只接受输入迭代器，这样insert(pos, 3, 5)会选中插入count个value的版本
+        template<class InputIt>
+        using if_input_iterator = typename std::enable_if<std::is_convertible<
+                typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>::type;
+
+        //只接受有begin()和end()的范围
+        template<class Range>
+        using if_range = decltype(std::begin(std::declval<const Range &>()), std::end(std::declval<const Range &>()));
+
+    public:
         /**
          * TODO Constructs
          * At least two: default constructor, copy constructor
          */
-        vector() {
-            maxsize = 300;
-            bbegin = alloc.allocate(300);
-            ssize = 0;
-        }
+        /**
+         * an empty vector allocates nothing, the first push_back (or reserve) does.
+         */
+        vector() : vector(Allocator()) {}
 
-        vector(const vector &other) {
-            if (other.maxsize > 0) {
-                bbegin = alloc.allocate(other.maxsize);
-                for (size_t i = 0; i < other.ssize; ++i) {
-                    alloc.construct(bbegin+i,*(other.bbegin+i));
+        explicit vector(const Allocator &_alloc)
+                : bbegin(this->inline_data()), ssize(0), maxsize(Inline), alloc(_alloc) {}
+
+        /**
+         * the copy gets exactly other.size() places (or the inline ones if they are enough).
+         */
+        vector(const vector &other)
+                : bbegin(this->inline_data()), ssize(0), maxsize(Inline),
+                  alloc(alloc_traits::select_on_container_copy_construction(other.alloc)) {
+            if (other.ssize > Inline) {
+                bbegin = alloc_traits::allocate(alloc, other.ssize);
+                try {
+                    copy_construct(other.bbegin, other.ssize, bbegin);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, bbegin, other.ssize);
+                    throw;
                 }
-            } else {
-                bbegin = nullptr;
+                maxsize = other.ssize;
+            } else if constexpr (Inline > 0) {
+                copy_construct(other.bbegin, other.ssize, bbegin);
             }
-            maxsize = other.maxsize;
             ssize = other.ssize;
         }
 
@@ -284,8 +440,8 @@ namespace sjtu {
          * TODO Destructor
          */
         ~vector() {
-            for(int i=0;i<ssize;++i) alloc.destroy(bbegin+i);
-            alloc.deallocate(bbegin, maxsize);
+            destroy_all();
+            release();
             maxsize = 0;
             ssize = 0;
             bbegin = nullptr;
@@ -296,17 +452,30 @@ namespace sjtu {
          */
         vector &operator=(const vector &other) {
             if (this == &other) return *this;
-            for(int i=0;i<ssize;++i) alloc.destroy(bbegin+i);
-            alloc.deallocate(bbegin,maxsize);
-            if (other.maxsize > 0) {
-                bbegin = alloc.allocate(other.maxsize);
-                for (size_t i = 0; i < other.ssize; ++i) {
-                   alloc.construct(bbegin+i,*(other.bbegin+i));
+            if (other.ssize <= Inline) {  //内置空间放得下：直接拷进去，失败时*this为空
+                destroy_all();
+                release();
+                bbegin = this->inline_data();
+                maxsize = Inline;
+                ssize = 0;
+                if constexpr (Inline > 0) copy_construct(other.bbegin, other.ssize, bbegin);
+                ssize = other.ssize;
+                return *this;
+            }
+            T *temp = nullptr;
+            if (other.ssize > 0) {   //先拷贝出新的空间，失败时*this保持原样
+                temp = alloc_traits::allocate(alloc, other.ssize);
+                try {
+                    copy_construct(other.bbegin, other.ssize, temp);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, temp, other.ssize);
+                    throw;
                 }
-            } else {
-                bbegin = nullptr;
             }
-            maxsize = other.maxsize;
+            destroy_all();
+            release();
+            bbegin = temp;
+            maxsize = other.ssize;
             ssize = other.ssize;
             return *this;
         }
@@ -336,21 +505,42 @@ namespace sjtu {
          * throw index_out_of_bound if pos is not in [0, size)
          * !!! Pay attentions
          *   In STL this operator does not check the boundary but I want you to do.
+         * the check can be turned off with the Check parameter, see bounds_check.
          */
         T &operator[](const size_t &pos) {
-            if (pos >= 0 && pos < ssize) {
-                return *(bbegin + pos);
-            } else {
-                throw index_out_of_bound();
+            if constexpr (checked) {
+                if (pos >= ssize) throw index_out_of_bound();
             }
+            return *(bbegin + pos);
         }
 
         const T &operator[](const size_t &pos) const {
-            if (pos >= 0 && pos < ssize) {
-                return *(bbegin + pos);
-            } else {
-                throw index_out_of_bound();
+            if constexpr (checked) {
+                if (pos >= ssize) throw index_out_of_bound();
             }
+            return *(bbegin + pos);
+        }
+
+        /**
+         * access the element at pos without any check, pos must be in [0, size).
+         */
+        T &unchecked(size_t pos) {
+            return *(bbegin + pos);
+        }
+
+        const T &unchecked(size_t pos) const {
+            return *(bbegin + pos);
+        }
+
+        /**
+         * returns a pointer to the first element, the elements are in [data(), data() + size()).
+         */
+        T *data() {
+            return bbegin;
+        }
+
+        const T *data() const {
+            return bbegin;
         }
 
         /**
@@ -381,22 +571,37 @@ namespace sjtu {
          * returns an iterator to the beginning.
          */
         iterator begin() {
-            return iterator(bbegin, this);
+            return make_iterator(bbegin);
+        }
+
+        const_iterator begin() const {
+            return make_iterator(bbegin);
         }
 
         const_iterator cbegin() const {
-            return const_iterator(bbegin, this);
+            return make_iterator(bbegin);
         }
 
         /**
          * returns an iterator to the end.
          */
         iterator end() {
-            return iterator(bbegin + ssize , this);
+            return make_iterator(bbegin + ssize);
+        }
+
+        const_iterator end() const {
+            return make_iterator(bbegin + ssize);
         }
 
         const_iterator cend() const {
-            return const_iterator(bbegin + ssize , this);
+            return make_iterator(bbegin + ssize);
+        }
+
+        /**
+         * returns the allocator associated with the container.
+         */
+        allocator_type get_allocator() const {
+            return alloc;
         }
 
         /**
@@ -414,28 +619,64 @@ namespace sjtu {
         }
 
         /**
-         * clears the contents
+         * returns the number of elements that can be held without reallocating.
+         */
+        size_t capacity() const {
+            return maxsize;
+        }
+
+        /**
+         * make room for at least n elements, so that the next n - size() insertions do not reallocate.
+         * does nothing if capacity() >= n already.
+         */
+        void reserve(size_t n) {
+            if (n > maxsize) reallocate(n);
+        }
+
+        /**
+         * give back the unused capacity, capacity() becomes size(),
+         *   or Inline when the elements fit in the inline places.
+         */
+        void shrink_to_fit() {
+            if (ssize < maxsize && !is_inline()) reallocate(ssize);
+        }
+
+        /**
+         * change the number of elements to n.
+         * new elements are value-initialized, or copies of value; extra elements are destroyed.
+         */
+        void resize(size_t n) {
+            resize_impl(n);
+        }
+
+        void resize(size_t n, const T &value) {
+            resize_impl(n, value);
+        }
+
+        /**
+         * clears the contents, the capacity is kept.
          */
         void clear() {
-            if (ssize > 0) {
-                ssize = 0;
-            }
+            destroy_all();
+            ssize = 0;
         }
 
         /**
          * inserts value before pos
          * returns an iterator pointing to the inserted value.
          */
-        iterator insert(iterator pos, const T &value) {   //注意：在doublespace以后，begin()与pos不再是指向同一个空间的迭代器，pos没有意义。
-            size_t ind=pos-begin();
-            if(ind>ssize) throw index_out_of_bound();
-            if(ssize==maxsize) double_space();
-            alloc.construct(bbegin+ssize,*(bbegin+ssize-1));
-            for(int i=ssize-1;i>=ind+1;--i) *(bbegin+i)=*(bbegin+i-1);
-            *(bbegin+ind)=value;
-            ssize++;
-            iterator iter(bbegin+ind,this);
-            return iter;
+        template<class It>
+        if_iterator<It> insert(It pos, const T &value) {   //注意：在doublespace以后，begin()与pos不再是指向同一个空间的迭代器，pos没有意义。
+            size_t ind = pos - begin();
+            if (ind > ssize) throw index_out_of_bound();
+            return emplace_at(ind, value);
+        }
+
+        template<class It>
+        if_iterator<It> insert(It pos, T &&value) {
+            size_t ind = pos - begin();
+            if (ind > ssize) throw index_out_of_bound();
+            return emplace_at(ind, std::move(value));
         }
 
         /**
@@ -445,26 +686,39 @@ namespace sjtu {
          * throw index_out_of_bound if ind > size (in this situation ind can be size because after inserting the size will increase 1.)
          */
         iterator insert(const size_t &ind, const T &value) {
-            if(ind>ssize) throw index_out_of_bound();
-            if(ssize==maxsize) double_space();
-            alloc.construct(bbegin+ssize,*(bbegin+ssize-1));
-            for(int i=ssize-1;i>=ind+1;--i) *(bbegin+i)=*(bbegin+i-1);
-            *(bbegin+ind)=value;
-            ssize++;
-            iterator iter(bbegin+ind,this);
-            return iter;
+            if (ind > ssize) throw index_out_of_bound();
+            return emplace_at(ind, value);
+        }
+
+        iterator insert(const size_t &ind, T &&value) {
+            if (ind > ssize) throw index_out_of_bound();
+            return emplace_at(ind, std::move(value));
+        }
+
+        /**
+         * constructs an element in place before pos from args.
+         * returns an iterator pointing to the new element.
+         */
+        template<class... Args>
+        iterator emplace(iterator pos, Args &&... args) {
+            size_t ind = pos - begin();
+            if (ind > ssize) throw index_out_of_bound();
+            return emplace_at(ind, std::forward<Args>(args)...);
         }
 
         /**
          * removes the element at pos.
          * return an iterator pointing to the following element.
          * If the iterator pos refers the last element, the end() iterator is returned.
+         * throw index_out_of_bound if pos is not in [begin(), end()), whatever the Check policy,
+         *   like the insertions and erase(ind).
          */
-        iterator erase(iterator pos) {
-            for(int i=pos-begin();i<ssize-1;++i) *(bbegin+i)=*(bbegin+i+1);
-            alloc.destroy(bbegin+ssize-1);
-            ssize--;
-            if(pos-begin()==ssize) return end();
+        template<class It>
+        if_iterator<It> erase(It pos) {
+            size_t ind = pos - begin();
+            if (ind >= ssize) throw index_out_of_bound();
+            erase_at(ind);
+            if (ind == ssize) return end();
             return pos;
         }
 
@@ -475,22 +729,148 @@ namespace sjtu {
          */
         iterator erase(const size_t &ind) {
             if(ind>=ssize) throw index_out_of_bound();
-            for(int i=ind;i<ssize-1;++i) *(bbegin+i)=*(bbegin+i+1);
-            alloc.destroy(bbegin+ssize-1);
-            ssize--;
+            erase_at(ind);
             if(ind==ssize) return end();
-            return iterator(bbegin+ind,this);
+            return make_iterator(bbegin + ind);
+        }
+
+        /**
+         * inserts the elements of [first, last) before pos, in order.
+         * the elements after pos are moved only once, and for forward iterators the
+         *   capacity grows at most once.
+         * first and last must not point into this vector.
+         * returns an iterator pointing to the first inserted element (pos if nothing is inserted).
+         */
+        template<class It, class InputIt, class = if_input_iterator<InputIt>>
+        if_iterator<It> insert(It pos, InputIt first, InputIt last) {
+            size_t ind = pos - begin();
+            if (ind > ssize) throw index_out_of_bound();
+            insert_range(ind, first, last);
+            return make_iterator(bbegin + ind);
+        }
+
+        /**
+         * inserts count copies of value before pos, moving the elements after pos only once.
+         * returns an iterator pointing to the first inserted element (pos if count == 0).
+         */
+        template<class It>
+        if_iterator<It> insert(It pos, size_t count, const T &value) {
+            size_t ind = pos - begin();
+            if (ind > ssize) throw index_out_of_bound();
+            insert_copies(ind, count, value);
+            return make_iterator(bbegin + ind);
+        }
+
+        /**
+         * the same two insertions at index ind.
+         * throw index_out_of_bound if ind > size
+         */
+        template<class InputIt, class = if_input_iterator<InputIt>>
+        iterator insert(const size_t &ind, InputIt first, InputIt last) {
+            if (ind > ssize) throw index_out_of_bound();
+            insert_range(ind, first, last);
+            return make_iterator(bbegin + ind);
+        }
+
+        iterator insert(const size_t &ind, size_t count, const T &value) {
+            if (ind > ssize) throw index_out_of_bound();
+            insert_copies(ind, count, value);
+            return make_iterator(bbegin + ind);
+        }
+
+        /**
+         * removes the elements in [first, last), moving the elements after them only once.
+         * returns an iterator pointing to the element that followed them.
+         */
+        template<class It>
+        if_iterator<It> erase(It first, It last) {
+            size_t ind = first - begin();
+            size_t n = last - first;
+            if (ind > ssize || n > ssize - ind) throw index_out_of_bound();
+            erase_n(ind, n);
+            return make_iterator(bbegin + ind);
+        }
+
+        /**
+         * adds the elements of [first, last), or of a range r, to the end.
+         * the range may be this vector itself.
+         */
+        template<class InputIt, class = if_input_iterator<InputIt>>
+        void append(InputIt first, InputIt last) {
+            insert_range(ssize, first, last);
+        }
+
+        template<class Range, class = if_range<Range>>
+        void append(const Range &r) {
+            insert_range(ssize, std::begin(r), std::end(r));
+        }
+
+        /**
+         * replaces the contents with the elements of [first, last), of a range r,
+         *   or with count copies of value.
+         * for forward iterators the capacity grows at most once, to exactly the new size.
+         * first and last must not point into this vector.
+         */
+        template<class InputIt, class = if_input_iterator<InputIt>>
+        void assign(InputIt first, InputIt last) {
+            assign_range(first, last);
+        }
+
+        template<class Range, class = if_range<Range>>
+        void assign(const Range &r) {
+            if constexpr (std::is_same<Range, vector>::value) {
+                if (&r == this) return;
+            }
+            assign_range(std::begin(r), std::end(r));
+        }
+
+        void assign(size_t count, const T &value) {
+            T temp(value);  //value可能是vector中的元素
+            assign_n(count, [&](T *p) { alloc_traits::construct(alloc, p, temp); });
         }
 
         /**
          * adds an element to the end.
          */
         void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * constructs an element in place at the end.
+         * args may refer to an element of this vector: the new element is built
+         *   before the old buffer is released.
+         */
+        template<class... Args>
+        T &emplace_back(Args &&... args) {
             if (ssize == maxsize) {
-                double_space();
+                size_t new_size = (maxsize > 0) ? 2 * maxsize : 1;
+                T *temp = alloc_traits::allocate(alloc, new_size);
+                try {
+                    alloc_traits::construct(alloc, temp + ssize, std::forward<Args>(args)...);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, temp, new_size);
+                    throw;
+                }
+                try {
+                    relocate(bbegin, ssize, temp);
+                } catch (...) {
+                    alloc_traits::destroy(alloc, temp + ssize);
+                    alloc_traits::deallocate(alloc, temp, new_size);
+                    throw;
+                }
+                release();
+                bbegin = temp;
+                maxsize = new_size;
+            } else {
+                alloc_traits::construct(alloc, bbegin + ssize, std::forward<Args>(args)...);
             }
             ++ssize;
-            alloc.construct(bbegin + ssize - 1,value) ;
+            return *(bbegin + ssize - 1);
         }
 
         /**
@@ -499,7 +879,7 @@ namespace sjtu {
          */
         void pop_back() {
             if (ssize == 0) throw container_is_empty();
-            alloc.destroy(bbegin+ssize-1);
+            alloc_traits::destroy(alloc, bbegin+ssize-1);
             ssize--;
         }
 
@@ -507,21 +887,355 @@ namespace sjtu {
         T *bbegin;
         size_t ssize;
         size_t maxsize;
-        std::allocator<T> alloc;   //一个属于vector的分配器对象
+        using alloc_traits = std::allocator_traits<Allocator>;
+        Allocator alloc;   //一个属于vector的分配器对象
         void double_space() {
-//            static int cnt=0;
-            T *temp = bbegin;
-            bbegin = alloc.allocate(2 * maxsize);
-            for (int i = 0; i < ssize; ++i) alloc.construct(bbegin+i,*(temp+i));
-            for (int i = 0; i < ssize; ++i) alloc.destroy(temp+i);
-            alloc.deallocate(temp, maxsize);
-            maxsize *= 2;
-//            cnt++;
-//            std::cout<<"cnt:"<<cnt<<'\n';
+            reallocate((maxsize > 0) ? 2 * maxsize : 1);
+        }
+
+        //release模式下迭代器就是指针
+        iterator make_iterator(T *p) {
+            if constexpr (checked_iterators) {
+                return iterator(p, this);
+            } else {
+                return p;
+            }
+        }
+
+        const_iterator make_iterator(const T *p) const {
+            if constexpr (checked_iterators) {
+                return const_iterator(p, this);
+            } else {
+                return p;
+            }
+        }
+
+        //元素是否放在对象内置的空间里
+        bool is_inline() const {
+            if constexpr (Inline > 0) {
+                return bbegin == this->inline_data();
+            } else {
+                return false;
+            }
+        }
+
+        //把元素搬到一块容量为new_size（>= ssize）的新空间，new_size为0时不分配。
+        //new_size不超过Inline时搬回内置空间（此时元素一定在堆上）。
+        void reallocate(size_t new_size) {
+            T *temp = this->inline_data();
+            if (new_size <= Inline) {
+                if constexpr (Inline > 0) relocate(bbegin, ssize, temp);  //Inline为0时ssize也是0
+                new_size = Inline;
+            } else {
+                temp = alloc_traits::allocate(alloc, new_size);
+                try {
+                    relocate(bbegin, ssize, temp);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc, temp, new_size);
+                    throw;
+                }
+            }
+            release();
+            bbegin = temp;
+            maxsize = new_size;
+        }
+
+        //归还当前的空间（元素已经析构或搬走），内置空间不用归还
+        void release() {
+            if (bbegin != nullptr && !is_inline()) alloc_traits::deallocate(alloc, bbegin, maxsize);
+        }
+
+        //args为空时值初始化新元素，否则从args（一个值）拷贝。
+        //需要扩容时先在新空间里构造新元素，再搬动旧元素，这样value可以引用vector中的元素。
+        template<class... Args>
+        void resize_impl(size_t n, const Args &... args) {
+            if (n <= ssize) {
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    for (size_t i = n; i < ssize; ++i) alloc_traits::destroy(alloc, bbegin + i);
+                }
+                ssize = n;
+                return;
+            }
+            if (n <= maxsize) {
+                size_t i = ssize;
+                try {
+                    for (; i < n; ++i) alloc_traits::construct(alloc, bbegin + i, args...);
+                } catch (...) {
+                    for (size_t j = ssize; j < i; ++j) alloc_traits::destroy(alloc, bbegin + j);
+                    throw;
+                }
+                ssize = n;
+                return;
+            }
+            size_t new_size = (n > 2 * maxsize) ? n : 2 * maxsize;
+            T *temp = alloc_traits::allocate(alloc, new_size);
+            size_t i = ssize;
+            try {
+                for (; i < n; ++i) alloc_traits::construct(alloc, temp + i, args...);
+                relocate(bbegin, ssize, temp);
+            } catch (...) {
+                for (size_t j = ssize; j < i; ++j) alloc_traits::destroy(alloc, temp + j);
+                alloc_traits::deallocate(alloc, temp, new_size);
+                throw;
+            }
+            release();
+            bbegin = temp;
+            maxsize = new_size;
+            ssize = n;
+        }
+
+        //把from中的n个元素搬到未初始化的to中，并析构from中的元素。
+        //移动构造不会抛出异常时使用移动，否则退回到拷贝，保证失败时原来的元素完好无损。
+        //可平凡重定位的类型直接按字节整体拷贝。
+        void relocate(T *from, size_t n, T *to) {
+            if constexpr (is_trivially_relocatable<T>::value) {
+                if (n > 0) std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), n * sizeof(T));
+            } else {
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) alloc_traits::construct(alloc, to + i, std::move_if_noexcept(*(from + i)));
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, to + j);
+                    throw;
+                }
+                for (i = 0; i < n; ++i) alloc_traits::destroy(alloc, from + i);
+            }
+        }
+
+        //把from中的n个元素拷贝构造到未初始化的to中。
+        void copy_construct(const T *from, size_t n, T *to) {
+            if constexpr (std::is_trivially_copyable<T>::value) {
+                if (n > 0) std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), n * sizeof(T));
+            } else {
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) alloc_traits::construct(alloc, to + i, *(from + i));
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, to + j);
+                    throw;
+                }
+            }
+        }
+
+        void destroy_all() {
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                for (size_t i = 0; i < ssize; ++i) alloc_traits::destroy(alloc, bbegin + i);
+            }
+        }
+
+        //在下标ind处构造新元素（ind <= ssize），后面的元素依次后移一位。
+        template<class... Args>
+        iterator emplace_at(size_t ind, Args &&... args) {
+            if (ind == ssize) {
+                emplace_back(std::forward<Args>(args)...);
+                return make_iterator(bbegin + ind);
+            }
+            T value(std::forward<Args>(args)...);  //先构造出新元素，args可能引用vector中的元素
+            if (ssize == maxsize) double_space();
+            if constexpr (is_trivially_relocatable<T>::value) {
+                //整段后移一位，空出来的位置是未初始化的内存
+                std::memmove(static_cast<void *>(bbegin + ind + 1), static_cast<const void *>(bbegin + ind),
+                             (ssize - ind) * sizeof(T));
+                try {
+                    alloc_traits::construct(alloc, bbegin + ind, std::move(value));
+                } catch (...) {
+                    std::memmove(static_cast<void *>(bbegin + ind), static_cast<const void *>(bbegin + ind + 1),
+                                 (ssize - ind) * sizeof(T));
+                    throw;
+                }
+            } else {
+                alloc_traits::construct(alloc, bbegin + ssize, std::move(*(bbegin + ssize - 1)));
+                for (size_t i = ssize - 1; i > ind; --i) *(bbegin + i) = std::move(*(bbegin + i - 1));
+                *(bbegin + ind) = std::move(value);
+            }
+            ssize++;
+            return make_iterator(bbegin + ind);
+        }
+
+        //删除下标ind处的元素（ind < ssize），后面的元素依次前移一位。
+        void erase_at(size_t ind) {
+            if constexpr (is_trivially_relocatable<T>::value) {
+                alloc_traits::destroy(alloc, bbegin + ind);
+                std::memmove(static_cast<void *>(bbegin + ind), static_cast<const void *>(bbegin + ind + 1),
+                             (ssize - ind - 1) * sizeof(T));
+            } else {
+                for (size_t i = ind; i + 1 < ssize; ++i) *(bbegin + i) = std::move(*(bbegin + i + 1));
+                alloc_traits::destroy(alloc, bbegin + ssize - 1);
+            }
+            ssize--;
+        }
+
+        //删除下标从ind开始的n个元素，后面的元素整体前移一次
+        void erase_n(size_t ind, size_t n) {
+            if (n == 0) return;
+            if constexpr (is_trivially_relocatable<T>::value) {
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    for (size_t i = ind; i < ind + n; ++i) alloc_traits::destroy(alloc, bbegin + i);
+                }
+                std::memmove(static_cast<void *>(bbegin + ind), static_cast<const void *>(bbegin + ind + n),
+                             (ssize - ind - n) * sizeof(T));
+            } else {
+                std::move(bbegin + ind + n, bbegin + ssize, bbegin + ind);
+                for (size_t i = ssize - n; i < ssize; ++i) alloc_traits::destroy(alloc, bbegin + i);
+            }
+            ssize -= n;
+        }
+
+        template<class InputIt>
+        void insert_range(size_t ind, InputIt first, InputIt last) {
+            using category = typename std::iterator_traits<InputIt>::iterator_category;
+            if constexpr (std::is_convertible<category, std::forward_iterator_tag>::value) {
+                size_t n = std::distance(first, last);
+                insert_n(ind, n, [&](T *p) {
+                    alloc_traits::construct(alloc, p, *first);
+                    ++first;
+                });
+            } else {
+                //不知道长度：先逐个加到末尾，再整体旋转到ind处
+                size_t old_size = ssize;
+                try {
+                    for (; first != last; ++first) emplace_back(*first);
+                } catch (...) {
+                    while (ssize > old_size) pop_back();
+                    throw;
+                }
+                std::rotate(bbegin + ind, bbegin + old_size, bbegin + ssize);
+            }
+        }
+
+        void insert_copies(size_t ind, size_t count, const T &value) {
+            if (count == 0) return;
+            T temp(value);  //value可能是vector中的元素，后移时会被移走
+            insert_n(ind, count, [&](T *p) { alloc_traits::construct(alloc, p, temp); });
+        }
+
+        //在下标ind处空出n个位置，依次调用make(p)在p处构造新元素。后面的元素只移动一次，最多扩容一次。
+        //需要扩容时先在新空间里构造新元素，再搬动旧元素，失败时*this保持原样。
+        template<class Make>
+        void insert_n(size_t ind, size_t n, Make make) {
+            if (n == 0) return;
+            if (n > maxsize - ssize) {
+                size_t new_size = (ssize + n > 2 * maxsize) ? ssize + n : 2 * maxsize;
+                T *temp = alloc_traits::allocate(alloc, new_size);
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) make(temp + ind + i);
+                    relocate_around(ind, n, temp);
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, temp + ind + j);
+                    alloc_traits::deallocate(alloc, temp, new_size);
+                    throw;
+                }
+                release();
+                bbegin = temp;
+                maxsize = new_size;
+                ssize += n;
+                return;
+            }
+            if constexpr (is_trivially_relocatable<T>::value) {
+                //整段后移n位，空出来的位置是未初始化的内存
+                std::memmove(static_cast<void *>(bbegin + ind + n), static_cast<const void *>(bbegin + ind),
+                             (ssize - ind) * sizeof(T));
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) make(bbegin + ind + i);
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, bbegin + ind + j);
+                    std::memmove(static_cast<void *>(bbegin + ind), static_cast<const void *>(bbegin + ind + n),
+                                 (ssize - ind) * sizeof(T));
+                    throw;
+                }
+                ssize += n;
+            } else {
+                //先构造在末尾，再整体旋转到ind处
+                size_t old_size = ssize;
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) make(bbegin + old_size + i);
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, bbegin + old_size + j);
+                    throw;
+                }
+                ssize += n;
+                std::rotate(bbegin + ind, bbegin + old_size, bbegin + ssize);
+            }
+        }
+
+        //把下标[0, ind)的元素搬到to，[ind, ssize)的元素搬到to + ind + n，并析构原来的元素。
+        //全部搬完才析构，失败时原来的元素完好无损。
+        void relocate_around(size_t ind, size_t n, T *to) {
+            if constexpr (is_trivially_relocatable<T>::value) {
+                if (ind > 0) std::memcpy(static_cast<void *>(to), static_cast<const void *>(bbegin), ind * sizeof(T));
+                if (ssize > ind) {
+                    std::memcpy(static_cast<void *>(to + ind + n), static_cast<const void *>(bbegin + ind),
+                                (ssize - ind) * sizeof(T));
+                }
+            } else {
+                size_t i = 0;
+                try {
+                    for (; i < ssize; ++i) {
+                        alloc_traits::construct(alloc, to + (i < ind ? i : i + n), std::move_if_noexcept(*(bbegin + i)));
+                    }
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, to + (j < ind ? j : j + n));
+                    throw;
+                }
+                destroy_all();
+            }
+        }
+
+        template<class InputIt>
+        void assign_range(InputIt first, InputIt last) {
+            using category = typename std::iterator_traits<InputIt>::iterator_category;
+            if constexpr (std::is_convertible<category, std::forward_iterator_tag>::value) {
+                size_t n = std::distance(first, last);
+                assign_n(n, [&](T *p) {
+                    alloc_traits::construct(alloc, p, *first);
+                    ++first;
+                });
+            } else {
+                clear();
+                for (; first != last; ++first) emplace_back(*first);
+            }
+        }
+
+        //用make依次构造n个新元素替换原来的内容。放不下时在恰好n个位置的新空间里构造，失败时*this保持原样；
+        //否则原地构造，失败时只保留已经构造好的元素。
+        template<class Make>
+        void assign_n(size_t n, Make make) {
+            if (n > maxsize) {
+                T *temp = alloc_traits::allocate(alloc, n);
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i) make(temp + i);
+                } catch (...) {
+                    for (size_t j = 0; j < i; ++j) alloc_traits::destroy(alloc, temp + j);
+                    alloc_traits::deallocate(alloc, temp, n);
+                    throw;
+                }
+                destroy_all();
+                release();
+                bbegin = temp;
+                maxsize = n;
+                ssize = n;
+                return;
+            }
+            clear();
+            for (; ssize < n; ++ssize) make(bbegin + ssize);
         }
     };
     template class vector<int>;
 
+/**
+ * a vector keeping up to N elements inside the object, for vectors that are usually small:
+ *   while size() <= N no memory is allocated and the elements sit right next to the
+ *   size and capacity. beyond N it grows on the heap like vector, and shrink_to_fit
+ *   brings it back inline once the elements fit again.
+ * it has all the interface of vector; the object is N * sizeof(T) bytes bigger.
+ */
+    template<typename T, size_t N, class Allocator = std::allocator<T>, bounds_check Check = default_bounds_check>
+    using small_vector = vector<T, Allocator, N, Check>;
+
 
 }
 